@@ -0,0 +1,132 @@
+/**
+ * @file gif_bench.cc
+ * @brief Замер кодирования кадров GIF через `GifEncoder`.
+ *
+ * Кодируются две серии кадров 640x480: каркас сферы, нарисованный
+ * `SoftwareRenderer` с поворотом между кадрами (немного цветов, меняется
+ * малая часть пикселей), и плавный градиент со сдвигом (тысячи цветов,
+ * меняется весь кадр). Для каждой серии и каждого способа приведения цветов
+ * печатается среднее время кадра и запас относительно записи в реальном
+ * времени при 10 кадрах в секунду.
+ *
+ * Использование: ./gif_bench [число кадров] (по умолчанию 20)
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <vector>
+
+#include "../model/concurrency/thread_pool.h"
+#include "../model/render/image_writer.h"
+#include "../model/render/software_renderer.h"
+
+namespace {
+
+constexpr int kWidth = 640;
+constexpr int kHeight = 480;
+
+std::vector<std::vector<std::uint8_t>> WireframeFrames(int count) {
+  std::vector<float> vertices;
+  std::vector<unsigned int> indices;
+  const int rows = 40, columns = 80;
+  for (int r = 0; r < rows; ++r) {
+    double theta = M_PI * (r + 0.5) / rows;
+    for (int c = 0; c < columns; ++c) {
+      double phi = 2 * M_PI * c / columns;
+      vertices.push_back(static_cast<float>(0.8 * std::sin(theta) *
+                                            std::cos(phi)));
+      vertices.push_back(static_cast<float>(0.8 * std::cos(theta)));
+      vertices.push_back(static_cast<float>(0.8 * std::sin(theta) *
+                                            std::sin(phi)));
+      unsigned int vertex = r * columns + c;
+      indices.push_back(vertex);
+      indices.push_back(r * columns + (c + 1) % columns);
+      if (r + 1 < rows) {
+        indices.push_back(vertex);
+        indices.push_back(vertex + columns);
+      }
+    }
+  }
+  s21::IndexBuffer faces(std::move(indices), vertices.size() / 3);
+  s21::RenderSettings settings;
+  settings.edges_color = {255, 160, 40, 255};
+  settings.vertex_color = {60, 200, 255, 255};
+  settings.background = {20, 20, 40, 255};
+  settings.parallel_projection = false;
+  s21::SoftwareRenderer renderer;
+  std::vector<std::vector<std::uint8_t>> frames;
+  for (int frame = 0; frame < count; ++frame) {
+    float angle = 0.05f * frame;
+    std::array<float, 16> model{std::cos(angle), 0, -std::sin(angle), 0,
+                                0, 1, 0, 0,
+                                std::sin(angle), 0, std::cos(angle), 0,
+                                0, 0, 0, 1};
+    renderer.Render(kWidth, kHeight, vertices, faces, model, settings);
+    frames.push_back(renderer.Pixels());
+  }
+  return frames;
+}
+
+std::vector<std::vector<std::uint8_t>> GradientFrames(int count) {
+  std::vector<std::vector<std::uint8_t>> frames;
+  for (int frame = 0; frame < count; ++frame) {
+    std::vector<std::uint8_t> pixels(kWidth * kHeight * 4);
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        std::uint8_t *pixel = &pixels[(y * kWidth + x) * 4];
+        pixel[0] = static_cast<std::uint8_t>(x * 255 / kWidth);
+        pixel[1] = static_cast<std::uint8_t>(y * 255 / kHeight);
+        pixel[2] = static_cast<std::uint8_t>(
+            128 + 127 * std::sin((x + y + frame * 16) * 0.01));
+        pixel[3] = 255;
+      }
+    }
+    frames.push_back(std::move(pixels));
+  }
+  return frames;
+}
+
+double SecondsPerFrame(const std::vector<std::vector<std::uint8_t>> &frames,
+                       s21::GifDither dither) {
+  std::string path =
+      (std::filesystem::temp_directory_path() / "s21_gif_bench.gif").string();
+  auto start = std::chrono::steady_clock::now();
+  {
+    s21::GifEncoder gif(path, kWidth, kHeight, 10, dither);
+    for (const auto &frame : frames) gif.AddFrame(frame);
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  std::filesystem::remove(path);
+  return elapsed.count() / frames.size();
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  int count = argc > 1 ? std::atoi(argv[1]) : 20;
+  std::printf("gif encoder: %d frames %dx%d, %u threads\n", count, kWidth,
+              kHeight, s21::ThreadPool::Instance().Size());
+  struct Series {
+    const char *name;
+    std::vector<std::vector<std::uint8_t>> frames;
+  } series[] = {{"wireframe", WireframeFrames(count)},
+                {"gradient", GradientFrames(count)}};
+  struct Mode {
+    const char *name;
+    s21::GifDither dither;
+  } modes[] = {{"threshold", s21::GifDither::kNone},
+               {"floyd-steinberg", s21::GifDither::kFloydSteinberg},
+               {"ordered", s21::GifDither::kOrdered}};
+  for (const Series &s : series) {
+    for (const Mode &mode : modes) {
+      double seconds = SecondsPerFrame(s.frames, mode.dither);
+      std::printf("  %-10s %-16s %8.1f ms/frame  %5.1fx real time\n", s.name,
+                  mode.name, seconds * 1e3, 0.1 / seconds);
+    }
+  }
+  return 0;
+}
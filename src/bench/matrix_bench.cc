@@ -0,0 +1,114 @@
+/**
+ * @file matrix_bench.cc
+ * @brief Сравнение умножения `s21::Matrix` с прежней реализацией на отдельных
+ * строках в куче.
+ *
+ * Прежняя реализация воспроизведена здесь: каждая строка выделяется отдельным
+ * `new double[]`, результат создаётся в куче и копируется в левый множитель,
+ * умножение выполняется тройным циклом k-i-j. Для каждого размера от 4x4 до
+ * 1024x1024 замеряется среднее время одного `MulMatrix`.
+ *
+ * Использование: ./matrix_bench [наибольший размер] (по умолчанию 1024)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "../libs/s21_matrix_oop.h"
+
+namespace {
+
+/// Матрица с прежним размещением: массив указателей на строки.
+struct RowMatrix {
+  int rows;
+  int cols;
+  double** data;
+
+  RowMatrix(int r, int c) : rows(r), cols(c), data(new double*[r]) {
+    for (int i = 0; i < rows; ++i) data[i] = new double[cols]();
+  }
+  ~RowMatrix() { Free(); }
+  RowMatrix(const RowMatrix&) = delete;
+  RowMatrix& operator=(const RowMatrix& other) {
+    Free();
+    rows = other.rows;
+    cols = other.cols;
+    data = new double*[rows];
+    for (int i = 0; i < rows; ++i) {
+      data[i] = new double[cols];
+      std::copy(other.data[i], other.data[i] + cols, data[i]);
+    }
+    return *this;
+  }
+  void Free() {
+    for (int i = 0; i < rows; ++i) delete[] data[i];
+    delete[] data;
+  }
+  void MulMatrix(const RowMatrix& other) {
+    RowMatrix result(rows, other.cols);
+    for (int k = 0; k < cols; ++k) {
+      for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < other.cols; ++j) {
+          result.data[i][j] += data[i][k] * other.data[k][j];
+        }
+      }
+    }
+    *this = result;
+  }
+};
+
+template <typename Function>
+double SecondsPerCall(Function function, int calls) {
+  auto start = std::chrono::steady_clock::now();
+  for (int call = 0; call < calls; ++call) function();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / calls;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int max_size = argc > 1 ? std::atoi(argv[1]) : 1024;
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+  std::printf("matrix multiply: old (rows in heap) vs s21::Matrix\n");
+  std::printf("  %6s  %12s  %12s  %8s  %8s\n", "size", "old", "new", "speedup",
+              "GFLOP/s");
+  for (int size = 4; size <= max_size; size *= 2) {
+    RowMatrix old_a(size, size), old_b(size, size);
+    s21::Matrix a(size, size), b(size, size);
+    for (int i = 0; i < size; ++i) {
+      for (int j = 0; j < size; ++j) {
+        a(i, j) = old_a.data[i][j] = dis(gen);
+        b(i, j) = old_b.data[i][j] = dis(gen);
+      }
+    }
+    RowMatrix old_saved(size, size);
+    old_saved = old_a;
+    s21::Matrix saved = a;
+
+    double flops = 2.0 * size * size * size;
+    int calls = static_cast<int>(std::clamp(2e8 / flops, 1.0, 1e6));
+    double old_time = SecondsPerCall(
+        [&] {
+          old_a = old_saved;
+          old_a.MulMatrix(old_b);
+        },
+        calls);
+    double new_time = SecondsPerCall(
+        [&] {
+          a = saved;
+          a.MulMatrix(b);
+        },
+        calls);
+    std::printf("  %6d  %10.3f us  %10.3f us  %7.1fx  %8.2f\n", size,
+                old_time * 1e6, new_time * 1e6, old_time / new_time,
+                flops / new_time / 1e9);
+  }
+  return 0;
+}
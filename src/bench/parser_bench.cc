@@ -0,0 +1,81 @@
+/**
+ * @file parser_bench.cc
+ * @brief Сравнение времени загрузки OBJ-файла в потоковом режиме и в режиме
+ * отображения файла в память.
+ *
+ * Генерирует сетку из N x N вершин с четырёхугольными гранями во временном
+ * файле и загружает её обоими режимами парсера. Режим отображения замеряется
+ * для числа потоков от 1 до числа аппаратных потоков.
+ *
+ * Использование: ./parser_bench [N] (по умолчанию N = 1000)
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "../model/parser/parser.h"
+
+namespace {
+
+void WriteGrid(const std::string& path, int n) {
+  std::ofstream out(path);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      out << "v " << i * 0.001f << ' ' << j * 0.001f << ' '
+          << (i * j % 97) * 0.0137f << '\n';
+    }
+  }
+  for (int i = 0; i + 1 < n; ++i) {
+    for (int j = 0; j + 1 < n; ++j) {
+      int a = i * n + j + 1;
+      out << "f " << a << ' ' << a + 1 << ' ' << a + n + 1 << ' ' << a + n
+          << '\n';
+    }
+  }
+}
+
+double LoadSeconds(const std::string& path, s21::LoadMode mode,
+                   unsigned int threads) {
+  double best = 1e30;
+  for (int run = 0; run < 3; ++run) {
+    s21::Parser parser;
+    parser.SetLoadMode(mode);
+    parser.SetThreadCount(threads);
+    auto start = std::chrono::steady_clock::now();
+    parser.LoadFile(path);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (elapsed.count() < best) best = elapsed.count();
+  }
+  return best;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int n = argc > 1 ? std::atoi(argv[1]) : 1000;
+  std::string path =
+      (std::filesystem::temp_directory_path() / "s21_parser_bench.obj")
+          .string();
+  WriteGrid(path, n);
+  double megabytes = std::filesystem::file_size(path) / (1024.0 * 1024.0);
+
+  double stream = LoadSeconds(path, s21::LoadMode::kStream, 1);
+  std::printf("parser: %d vertices, %.1f MB\n", n * n, megabytes);
+  std::printf("  stream            %8.3f s  %8.1f MB/s\n", stream,
+              megabytes / stream);
+  unsigned int hardware = std::thread::hardware_concurrency();
+  for (unsigned int threads = 1; threads <= (hardware ? hardware : 1);
+       threads *= 2) {
+    double mapped = LoadSeconds(path, s21::LoadMode::kMapped, threads);
+    std::printf("  mapped %2u thr.   %8.3f s  %8.1f MB/s  (x%.2f)\n", threads,
+                mapped, megabytes / mapped, stream / mapped);
+  }
+  std::filesystem::remove(path);
+  return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file render_bench.cc
+ * @brief Замер программной отрисовки `SoftwareRenderer` на большой модели.
+ *
+ * Модель - сетка на сфере, в которой каждая вершина соединена с соседями
+ * справа и снизу, поэтому рёбер вдвое больше, чем вершин. Кадр рисуется в
+ * центральной и параллельной проекции, со сплошными и пунктирными рёбрами;
+ * для каждого варианта печатается среднее время кадра.
+ *
+ * Использование: ./render_bench [число рёбер] [ширина] [высота]
+ * (по умолчанию 1000000 рёбер, 1920x1080)
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../model/concurrency/thread_pool.h"
+#include "../model/render/software_renderer.h"
+
+namespace {
+
+template <typename Function>
+double SecondsPerCall(Function function, int calls) {
+  auto start = std::chrono::steady_clock::now();
+  for (int call = 0; call < calls; ++call) function();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / calls;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t edges = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  int width = argc > 2 ? std::atoi(argv[2]) : 1920;
+  int height = argc > 3 ? std::atoi(argv[3]) : 1080;
+
+  std::size_t columns = static_cast<std::size_t>(std::sqrt(edges / 2.0)) + 1;
+  std::size_t rows = edges / 2 / columns + 1;
+  std::vector<float> vertices;
+  vertices.reserve(rows * columns * 3);
+  for (std::size_t r = 0; r < rows; ++r) {
+    double theta = M_PI * (r + 0.5) / rows;
+    for (std::size_t c = 0; c < columns; ++c) {
+      double phi = 2 * M_PI * c / columns;
+      vertices.push_back(static_cast<float>(0.8 * std::sin(theta) *
+                                            std::cos(phi)));
+      vertices.push_back(static_cast<float>(0.8 * std::cos(theta)));
+      vertices.push_back(static_cast<float>(0.8 * std::sin(theta) *
+                                            std::sin(phi)));
+    }
+  }
+  std::vector<unsigned int> indices;
+  indices.reserve(edges * 2);
+  for (std::size_t r = 0; r < rows && indices.size() < edges * 2; ++r) {
+    for (std::size_t c = 0; c < columns && indices.size() < edges * 2; ++c) {
+      unsigned int vertex = static_cast<unsigned int>(r * columns + c);
+      indices.push_back(vertex);
+      indices.push_back(static_cast<unsigned int>(r * columns +
+                                                  (c + 1) % columns));
+      if (r + 1 < rows) {
+        indices.push_back(vertex);
+        indices.push_back(vertex + static_cast<unsigned int>(columns));
+      }
+    }
+  }
+  s21::IndexBuffer faces(std::move(indices), rows * columns);
+  const std::array<float, 16> model{1, 0, 0, 0, 0, 1, 0, 0,
+                                    0, 0, 1, 0, 0, 0, 0, 1};
+
+  std::printf("software renderer: %zu vertices, %zu edges, %dx%d, %u threads\n",
+              vertices.size() / 3, faces.Size() / 2, width, height,
+              s21::ThreadPool::Instance().Size());
+  s21::SoftwareRenderer renderer;
+  for (bool parallel : {false, true}) {
+    for (bool dashed : {false, true}) {
+      s21::RenderSettings settings;
+      settings.parallel_projection = parallel;
+      settings.dashed_edges = dashed;
+      settings.vertex_shape = s21::PointShape::kNone;
+      auto frame = [&] {
+        renderer.Render(width, height, vertices, faces, model, settings);
+      };
+      frame();
+      double seconds = SecondsPerCall(frame, 5);
+      std::printf("  %-8s %-6s  %8.1f ms/frame\n",
+                  parallel ? "parallel" : "central",
+                  dashed ? "dashed" : "solid", seconds * 1e3);
+    }
+  }
+  s21::RenderSettings settings;
+  settings.parallel_projection = false;
+  auto frame = [&] {
+    renderer.Render(width, height, vertices, faces, model, settings);
+  };
+  frame();
+  std::printf("  central  points  %8.1f ms/frame\n",
+              SecondsPerCall(frame, 5) * 1e3);
+  return 0;
+}
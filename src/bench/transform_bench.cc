@@ -0,0 +1,202 @@
+/**
+ * @file transform_bench.cc
+ * @brief Сравнение скорости преобразования вершин через `s21::Matrix` и через
+ * `Mat4` фиксированного размера.
+ *
+ * Первый замер повторяет прежний цикл `PrivateTransformVertices`: для каждой
+ * вершины создаётся матрица 1x4 `s21::Matrix` и умножается на матрицу
+ * преобразования. Второй замер выполняет `AffineTransform::TransformVertices`.
+ * Затем `TransformKernel` замеряется для каждого набора инструкций,
+ * поддерживаемого процессором, и для специализированных ядер одиночных
+ * преобразований в сравнении с общим ядром на той же матрице. Поворот
+ * смещённой модели сравнивается с прежними тремя проходами T(-t), M, T(t).
+ * В конце сравнивается построение матрицы через `FactoryMethod` в куче и через
+ * `GeneralMatrixBuilder::Build` на стеке.
+ *
+ * Использование: ./transform_bench [число вершин] (по умолчанию 1000000)
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../libs/s21_matrix_oop.h"
+#include "../model/affine_transform/affinetransform.h"
+#include "../model/affine_transform/transform_kernel.h"
+
+// Счётчик выделений памяти для сравнения способов построения матрицы.
+static std::size_t g_allocations = 0;
+
+void* operator new(std::size_t size) {
+  ++g_allocations;
+  if (void* pointer = std::malloc(size)) return pointer;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+namespace {
+
+constexpr int kRuns = 5;
+
+void HeapMatrixTransform(std::vector<float>& vertices,
+                         const s21::TransformMatrix& transform) {
+  s21::Matrix matrix(4, 4);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) matrix(i, j) = transform(i, j);
+  }
+  for (size_t i = 0; i < vertices.size(); i += 3) {
+    s21::Matrix m_vert(1, 4);
+    m_vert(0, 0) = vertices[i];
+    m_vert(0, 1) = vertices[i + 1];
+    m_vert(0, 2) = vertices[i + 2];
+    m_vert(0, 3) = 1;
+    m_vert.MulMatrix(matrix);
+    vertices[i] = m_vert(0, 0);
+    vertices[i + 1] = m_vert(0, 1);
+    vertices[i + 2] = m_vert(0, 2);
+  }
+}
+
+template <typename Function>
+double BestSeconds(Function function) {
+  double best = 1e30;
+  for (int run = 0; run < kRuns; ++run) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (elapsed.count() < best) best = elapsed.count();
+  }
+  return best;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+  std::vector<float> vertices(count * 3);
+  for (float& value : vertices) value = dis(gen);
+
+  TransformParametrs delta = {{0, 0, 0}, {0, 0, 0}, {0.01f, 0.02f, 0.03f}};
+  s21::GeneralTransformMatrix transform;
+  transform.SetTransformMatrix(delta);
+
+  std::vector<float> heap_vertices = vertices;
+  double heap =
+      BestSeconds([&] { HeapMatrixTransform(heap_vertices, transform); });
+
+  std::vector<float> stack_vertices = vertices;
+  s21::AffineTransform affine;
+  affine.AddVertices(&stack_vertices);
+  double stack = BestSeconds([&] { affine.TransformVertices(delta); });
+
+  std::printf("transform: %zu vertices\n", count);
+  std::printf("  s21::Matrix         %8.3f s  %8.1f Mvert/s\n", heap,
+              count / heap / 1e6);
+  std::printf("  Mat4 (stack)        %8.3f s  %8.1f Mvert/s  (x%.1f)\n", stack,
+              count / stack / 1e6, heap / stack);
+
+  const char* names[] = {"scalar", "SSE2", "AVX2", "AVX-512"};
+  s21::SimdLevel supported = s21::TransformKernel::DetectLevel();
+  for (int level = 0; level <= static_cast<int>(supported); ++level) {
+    double kernel = BestSeconds([&] {
+      s21::TransformKernel::Transform(
+          transform.GetMatrix(), vertices.data(), stack_vertices.data(), count,
+          static_cast<s21::SimdLevel>(level));
+    });
+    std::printf("  kernel %-8s     %8.3f s  %8.1f Mvert/s  %6.1f GB/s\n",
+                names[level], kernel, count / kernel / 1e6,
+                count * 24.0 / kernel / 1e9);
+  }
+
+  struct ShapeCase {
+    const char* name;
+    TransformParametrs delta;
+    s21::TransformShape shape;
+  };
+  const ShapeCase shapes[] = {
+      {"translate", {{0, 0, 0}, {0.1f, 0, 0}, {0, 0, 0}},
+       s21::TransformShape::kTranslate},
+      {"scale", {{1.01f, 1.01f, 1.01f}, {0, 0, 0}, {0, 0, 0}},
+       s21::TransformShape::kScale},
+      {"rotate X", {{0, 0, 0}, {0, 0, 0}, {0.01f, 0, 0}},
+       s21::TransformShape::kRotateX},
+  };
+  for (const ShapeCase& shape : shapes) {
+    s21::GeneralTransformMatrix matrix;
+    matrix.SetTransformMatrix(shape.delta);
+    double general = BestSeconds([&] {
+      s21::TransformKernel::Transform(matrix.GetMatrix(), vertices.data(),
+                                      stack_vertices.data(), count);
+    });
+    double special = BestSeconds([&] {
+      s21::TransformKernel::Transform(matrix.GetMatrix(), vertices.data(),
+                                      stack_vertices.data(), count,
+                                      shape.shape);
+    });
+    std::printf("  %-9s general %8.1f Mvert/s, specialized %8.1f Mvert/s\n",
+                shape.name, count / general / 1e6, count / special / 1e6);
+  }
+
+  TransformParametrs move = {{0, 0, 0}, {0.5f, -0.25f, 0.125f}, {0, 0, 0}};
+  TransformParametrs to_local = {{0, 0, 0}, {-0.5f, 0.25f, -0.125f}, {0, 0, 0}};
+  TransformParametrs rotate = {{0, 0, 0}, {0, 0, 0}, {0, 0.01f, 0}};
+  const std::pair<TransformParametrs, s21::TransformShape> passes[] = {
+      {to_local, s21::TransformShape::kTranslate},
+      {rotate, s21::TransformShape::kRotateY},
+      {move, s21::TransformShape::kTranslate}};
+  double three_passes = BestSeconds([&] {
+    for (const auto& [pass, shape] : passes) {
+      s21::TransformKernel::Transform(
+          s21::GeneralMatrixBuilder::Build(pass).GetMatrix(),
+          stack_vertices.data(), stack_vertices.data(), count, shape);
+    }
+  });
+  s21::AffineTransform moved;
+  moved.AddVertices(&stack_vertices);
+  moved.TransformVertices(move);
+  double fused = BestSeconds([&] { moved.TransformVertices(rotate); });
+  std::printf("  moved rotate: 3 passes %8.1f Mvert/s, fused %8.1f Mvert/s\n",
+              count / three_passes / 1e6, count / fused / 1e6);
+
+  constexpr int kBuilds = 1000000;
+  volatile double sink = 0;
+  std::size_t allocations = g_allocations;
+  double heap_build = BestSeconds([&] {
+    for (int i = 0; i < kBuilds; ++i) {
+      s21::MatrixBuilder* creator = new s21::GeneralMatrixBuilder();
+      s21::TransformMatrix* matrix = creator->FactoryMethod();
+      matrix->SetTransformMatrix(delta);
+      sink = (*matrix)(0, 0);
+      delete matrix;
+      delete creator;
+    }
+  });
+  double heap_allocations =
+      double(g_allocations - allocations) / kBuilds / kRuns;
+  allocations = g_allocations;
+  double static_build = BestSeconds([&] {
+    for (int i = 0; i < kBuilds; ++i) {
+      sink = s21::GeneralMatrixBuilder::Build(delta)(0, 0);
+    }
+  });
+  double static_allocations =
+      double(g_allocations - allocations) / kBuilds / kRuns;
+  std::printf("  setup FactoryMethod  %6.1f ns  %4.1f allocations\n",
+              heap_build / kBuilds * 1e9, heap_allocations);
+  std::printf("  setup Build          %6.1f ns  %4.1f allocations\n",
+              static_build / kBuilds * 1e9, static_allocations);
+  return 0;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file batch_render.cc
+ * @brief Консольная программа пакетной отрисовки превью моделей.
+ *
+ * Разбирает аргументы `BatchRenderer::ParseArguments`, рисует все модели и
+ * печатает по строке на файл. Код возврата: 0 - все файлы отрисованы, 1 -
+ * хотя бы один файл не удалось обработать, 2 - ошибка в аргументах.
+ */
+
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "../model/render/batch_renderer.h"
+
+int main(int argc, char *argv[]) {
+  s21::BatchOptions options;
+  try {
+    options = s21::BatchRenderer::ParseArguments(
+        std::vector<std::string>(argv + 1, argv + argc));
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "%s\n\n%s", e.what(), s21::BatchRenderer::Usage());
+    return 2;
+  }
+  if (options.help) {
+    std::fputs(s21::BatchRenderer::Usage(), stdout);
+    return 0;
+  }
+
+  int failed = 0;
+  try {
+    s21::BatchRenderer renderer(options);
+    renderer.Run([&failed](const s21::BatchResult &result) {
+      if (!result.error.empty()) {
+        ++failed;
+        std::fprintf(stderr, "%s: %s\n", result.input.c_str(),
+                     result.error.c_str());
+        return;
+      }
+      for (const std::string &output : result.outputs) {
+        std::printf("%s -> %s (%.2f s)\n", result.input.c_str(),
+                    output.c_str(), result.seconds);
+      }
+    });
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  return failed ? 1 : 0;
+}
@@ -6,6 +6,8 @@
  */
 #include "controller.h"
 
+#include <memory>
+
 #include "../view/view.h"
 
 namespace s21 {
@@ -19,29 +21,72 @@ s21::Controller::Controller(Model* model, View* view)
   connect(view, &View::moveChanged, this, &Controller::OnMoveChanged);
   connect(view, &View::rotateChanged, this, &Controller::OnRotateChanged);
   connect(view, &View::scaleChanged, this, &Controller::OnScaleChanged);
+  connect(view, &View::loadCancelRequested, this, &Controller::CancelLoading);
+  connect(view, &View::cacheToggled, this,
+          [this](bool enabled) { model_->SetCacheEnabled(enabled); });
+  connect(this, &Controller::modelLoaded, view, &View::ShowModelInfo);
 }
 
-s21::Controller::~Controller() {}
+s21::Controller::~Controller() {
+  loader_.Cancel();
+  loader_.Wait();
+}
 
 void s21::Controller::LoadModel(const std::string& path) {
-  view_->resetSliders();
-  auto [success, error_message] = model_->LoadFile(path);
-  if (!success) {
-    view_->ShowError("Failed to load model: " + error_message);
+  // Результаты и ход предыдущих загрузок, уже поставленные в очередь событий,
+  // отбрасываются по номеру загрузки.
+  unsigned int job = ++load_job_;
+  view_->ShowLoadStarted(QString::fromStdString(path));
+  loader_.Start(
+      path, model_->IsCacheEnabled(),
+      [this, job](const LoadProgress& progress) {
+        QMetaObject::invokeMethod(
+            this,
+            [this, job, progress] {
+              if (job == load_job_) view_->ShowLoadProgress(progress);
+            },
+            Qt::QueuedConnection);
+      },
+      [this, job, path](LoadResult result) {
+        auto shared = std::make_shared<LoadResult>(std::move(result));
+        QMetaObject::invokeMethod(
+            this,
+            [this, job, path, shared] {
+              if (job == load_job_) OnLoadFinished(path, std::move(*shared));
+            },
+            Qt::QueuedConnection);
+      });
+}
+
+void s21::Controller::CancelLoading() { loader_.Cancel(); }
+
+void s21::Controller::OnLoadFinished(const std::string& path,
+                                     LoadResult result) {
+  view_->ShowLoadFinished();
+  if (result.canceled) return;
+  if (!result.success) {
+    view_->ShowError("Failed to load model: " + result.error);
     return;
   }
+  // Слайдеры сбрасываются до замены данных, чтобы их изменения применились к
+  // старой модели.
+  view_->resetSliders();
+  model_->SetData(std::move(result.data));
   delta_ = {};
-  const auto& vertices = model_->GetVertices();
-  const auto& faces = model_->GetFaces();
-  view_->getModelRenderWidget()->setModelData(vertices, faces);
+  view_->getModelRenderWidget()->setModelData(model_->GetMesh());
+  view_->getModelRenderWidget()->setModelMatrix(model_->GetModelMatrix());
+  emit modelLoaded(model_->GetStats(), QString::fromStdString(path));
 }
 
 void s21::Controller::UpdateModel() {
   model_->Transform(delta_);
   delta_ = {};
-  const auto& vertices = model_->GetVertices();
-  const auto& faces = model_->GetFaces();
-  view_->getModelRenderWidget()->setModelData(vertices, faces);
+  if (model_->GetTransformMode() == TransformMode::kRetained) {
+    view_->getModelRenderWidget()->setModelMatrix(model_->GetModelMatrix());
+    return;
+  }
+  // Грани не менялись, поэтому передаётся только новая версия вершин.
+  view_->getModelRenderWidget()->setModelData(model_->GetMesh());
 }
 
 void s21::Controller::OnMoveChanged(float value, Axis axis) {
@@ -8,7 +8,9 @@
  * Основные задачи:
  * - Прием сигналов от представления и изменение модели (перемещение, вращение,
  * масштабирование).
- * - Загрузка модели из файла и передача данных в представление.
+ * - Фоновая загрузка модели из файла с отображением хода загрузки, её отмена и
+ * передача данных в представление; о загруженной модели сообщает сигнал
+ * `modelLoaded`.
  * - Обновление представления после применения изменений в модели.
  *
  * Используется паттерн "наблюдатель", где Controller является подписчиком на
@@ -21,6 +23,7 @@
 #include <QObject>
 
 #include "../model/model.h"
+#include "../model/model_loader.h"
 #include "axis.h"
 
 namespace s21 {
@@ -59,19 +62,53 @@ class Controller : public QObject {
   ~Controller();
 
   /**
-   * @brief Загружает модель из файла и передает данные в представление.
+   * @brief Начинает фоновую загрузку модели из файла.
    *
-   * Этот метод загружает модель из указанного файла и передает информацию о
-   * вершинах и гранях модели в представление для отображения.
+   * Файл разбирается в рабочем потоке, ход загрузки передаётся в
+   * представление. Текущая модель остаётся доступной для взаимодействия, пока
+   * загрузка не завершится; новая модель заменяет её целиком в потоке
+   * интерфейса. Начало новой загрузки отменяет предыдущую.
    *
    * @param path Путь к файлу модели.
    */
   void LoadModel(const std::string& path);
 
+  /**
+   * @brief Отменяет текущую загрузку модели.
+   */
+  void CancelLoading();
+
+ private:
+  /**
+   * @brief Применяет результат фоновой загрузки.
+   *
+   * Вызывается в потоке интерфейса. При успехе заменяет данные модели и
+   * передает их в представление, иначе сообщает об ошибке.
+   *
+   * @param path Путь к файлу модели.
+   * @param result Результат загрузки.
+   */
+  void OnLoadFinished(const std::string& path, LoadResult result);
+
+ signals:
+  /**
+   * @brief Сигнал, испускаемый после замены модели загруженной.
+   *
+   * Сведения о модели собраны при загрузке, поэтому подписчикам не нужно
+   * обходить вершины и рёбра.
+   *
+   * @param stats Сведения о модели.
+   * @param filePath Путь к файлу модели.
+   */
+  void modelLoaded(const MeshStats& stats, const QString& filePath);
+
  private:
+
   Model* model_;              ///< Указатель на модель.
   View* view_;                ///< Указатель на представление.
   TransformParametrs delta_;  ///< Параметры трансформации модели.
+  ModelLoader loader_;        ///< Фоновый загрузчик модели.
+  unsigned int load_job_ = 0;  ///< Номер текущей загрузки.
 
  private slots:
 
@@ -79,7 +116,8 @@ class Controller : public QObject {
    * @brief Обновляет модель с учетом трансформаций.
    *
    * Применяет изменения трансформации (перемещения, вращения, масштабирования)
-   * к модели.
+   * к модели. В режиме `TransformMode::kRetained` в представление передаётся
+   * только матрица модели, без копирования вершин.
    */
   void UpdateModel();
 
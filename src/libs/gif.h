@@ -18,6 +18,11 @@
 //
 // Only RGBA8 is currently supported as an input format. (The alpha is ignored.)
 //
+// Palette construction, thresholding and ordered dithering split their work
+// into independent tasks. Define GIF_PARALLEL_FOR(count, task) before
+// including this file to run task(i) for i in [0, count) on a thread pool;
+// by default the tasks run one after another on the calling thread.
+//
 // If capturing a buffer with a bottom-left origin (such as OpenGL), define
 // GIF_FLIP_VERT to automatically flip the buffer data when writing the image
 // (the buffer itself is unchanged.
@@ -32,6 +37,7 @@
 #define gif_h
 
 #include <stdbool.h>  // for bool macros
+#include <atomic>     // for the shared color cache
 #include <stdint.h>   // for integer typedefs
 #include <stdio.h>    // for FILE*
 #include <string.h>   // for memcpy and bzero
@@ -63,8 +69,37 @@
 #define GIF_FREE free
 #endif
 
+#ifndef GIF_PARALLEL_FOR
+#define GIF_PARALLEL_FOR(count, task) \
+  for (int gifTask = 0; gifTask < (count); ++gifTask) (task)(gifTask)
+#endif
+
 const int kGifTransIndex = 0;
 
+// Ways to map frame colors to the palette (the dither argument of
+// GifWriteFrame). Floyd-Steinberg carries error from pixel to pixel and runs
+// serially; ordered dithering adds a fixed 8x8 Bayer offset per pixel, so
+// rows are independent and run in parallel.
+const int kGifDitherNone = 0;
+const int kGifDitherFloydSteinberg = 1;
+const int kGifDitherOrdered = 2;
+
+// Rows handled by one task of the row-parallel passes
+const int kGifRowsPerTask = 16;
+
+// Tree levels of the median split built before the subtrees are handed out
+// as parallel tasks (2^level subtrees)
+const int kGifParallelTreeLevel = 3;
+
+// Direct-mapped cache of nearest palette entries. An entry holds the 24-bit
+// color in its high bits and the palette index in the low 8 bits, so a hit
+// is exact; 0 marks an empty entry, since a color never maps to the
+// transparent index. Entries are atomic so that parallel passes can fill the
+// cache concurrently.
+const int kGifColorCacheBits = 16;
+const int kGifColorCacheSize = 1 << kGifColorCacheBits;
+typedef std::atomic<uint32_t> GifColorCache[kGifColorCacheSize];
+
 typedef struct {
   int bitDepth;
 
@@ -135,6 +170,31 @@ void GifGetClosestPaletteColor(GifPalette* pPal, int r, int g, int b,
   }
 }
 
+// Looks up the palette entry nearest to a color, walking the k-d tree only
+// the first time the color is seen in a frame. Colors outside 0..255 (from
+// accumulated dithering error) are not cached.
+int GifCachedPaletteColor(GifPalette* pPal, GifColorCache& cache, int r,
+                          int g, int b) {
+  bool inRange = (unsigned)r < 256 && (unsigned)g < 256 && (unsigned)b < 256;
+  uint32_t color = ((uint32_t)r << 16) | ((uint32_t)g << 8) | (uint32_t)b;
+  uint32_t slot = (color * 2654435761u) >> (32 - kGifColorCacheBits);
+  if (inRange) {
+    uint32_t entry = cache[slot].load(std::memory_order_relaxed);
+    if (entry != 0 && entry >> 8 == color) return (int)(entry & 0xFF);
+  }
+  int bestDiff = 1000000;
+  int ind = 1;
+  GifGetClosestPaletteColor(pPal, r, g, b, &ind, &bestDiff, 1);
+  if (inRange)
+    cache[slot].store((color << 8) | (uint32_t)ind, std::memory_order_relaxed);
+  return ind;
+}
+
+void GifClearColorCache(GifColorCache& cache) {
+  for (int ii = 0; ii < kGifColorCacheSize; ++ii)
+    cache[ii].store(0, std::memory_order_relaxed);
+}
+
 void GifSwapPixels(uint8_t* image, int pixA, int pixB) {
   uint8_t rA = image[pixA * 4];
   uint8_t gA = image[pixA * 4 + 1];
@@ -206,6 +266,77 @@ int GifPartitionByMean(uint8_t* image, int left, int right, int com,
   return left;
 }
 
+// Splits one inner node of the palette tree: partitions the node's pixels
+// along the axis with the largest range and stores the split in the tree.
+// Returns the number of pixels that go to the left subtree.
+int GifSplitNode(uint8_t* image, int numPixels, int treeNode, int treeLevel,
+                 GifPalette* pal) {
+  int numColors = (1 << pal->bitDepth);
+
+  // Find the axis with the largest range
+  int minR = 255, maxR = 0;
+  int minG = 255, maxG = 0;
+  int minB = 255, maxB = 0;
+  for (int ii = 0; ii < numPixels; ++ii) {
+    int r = image[ii * 4 + 0];
+    int g = image[ii * 4 + 1];
+    int b = image[ii * 4 + 2];
+
+    if (r > maxR) maxR = r;
+    if (r < minR) minR = r;
+
+    if (g > maxG) maxG = g;
+    if (g < minG) minG = g;
+
+    if (b > maxB) maxB = b;
+    if (b < minB) minB = b;
+  }
+
+  int rRange = maxR - minR;
+  int gRange = maxG - minG;
+  int bRange = maxB - minB;
+
+  // and split along that axis. (incidentally, this means this isn't a "proper"
+  // k-d tree but I don't know what else to call it)
+  int splitCom = 1;
+  int rangeMin = minG;
+  int rangeMax = maxG;
+  if (bRange > gRange) {
+    splitCom = 2;
+    rangeMin = minB;
+    rangeMax = maxB;
+  }
+  if (rRange > bRange && rRange > gRange) {
+    splitCom = 0;
+    rangeMin = minR;
+    rangeMax = maxR;
+  }
+
+  int subPixelsA = numPixels / 2;
+
+  GifPartitionByMedian(image, 0, numPixels, splitCom, subPixelsA);
+  int splitValue = image[subPixelsA * 4 + splitCom];
+
+  // if the split is very unbalanced, split at the mean instead of the median to
+  // preserve rare colors
+  int splitUnbalance =
+      GifIAbs((splitValue - rangeMin) - (rangeMax - splitValue));
+  if (splitUnbalance > (1536 >> treeLevel)) {
+    splitValue = rangeMin + (rangeMax - rangeMin) / 2;
+    subPixelsA = GifPartitionByMean(image, 0, numPixels, splitCom, splitValue);
+  }
+
+  // add the bottom node for the transparency index
+  if (treeNode == numColors / 2) {
+    subPixelsA = 0;
+    splitValue = 0;
+  }
+
+  pal->treeSplitElt[treeNode] = (uint8_t)splitCom;
+  pal->treeSplit[treeNode] = (uint8_t)splitValue;
+  return subPixelsA;
+}
+
 // Builds a palette by creating a balanced k-d tree of all pixels in the image
 void GifSplitPalette(uint8_t* image, int numPixels, int treeNode, int treeLevel,
                      bool buildForDither, GifPalette* pal) {
@@ -277,68 +408,8 @@ void GifSplitPalette(uint8_t* image, int numPixels, int treeNode, int treeLevel,
     return;
   }
 
-  // Find the axis with the largest range
-  int minR = 255, maxR = 0;
-  int minG = 255, maxG = 0;
-  int minB = 255, maxB = 0;
-  for (int ii = 0; ii < numPixels; ++ii) {
-    int r = image[ii * 4 + 0];
-    int g = image[ii * 4 + 1];
-    int b = image[ii * 4 + 2];
-
-    if (r > maxR) maxR = r;
-    if (r < minR) minR = r;
-
-    if (g > maxG) maxG = g;
-    if (g < minG) minG = g;
-
-    if (b > maxB) maxB = b;
-    if (b < minB) minB = b;
-  }
-
-  int rRange = maxR - minR;
-  int gRange = maxG - minG;
-  int bRange = maxB - minB;
-
-  // and split along that axis. (incidentally, this means this isn't a "proper"
-  // k-d tree but I don't know what else to call it)
-  int splitCom = 1;
-  int rangeMin = minG;
-  int rangeMax = maxG;
-  if (bRange > gRange) {
-    splitCom = 2;
-    rangeMin = minB;
-    rangeMax = maxB;
-  }
-  if (rRange > bRange && rRange > gRange) {
-    splitCom = 0;
-    rangeMin = minR;
-    rangeMax = maxR;
-  }
-
-  int subPixelsA = numPixels / 2;
-
-  GifPartitionByMedian(image, 0, numPixels, splitCom, subPixelsA);
-  int splitValue = image[subPixelsA * 4 + splitCom];
-
-  // if the split is very unbalanced, split at the mean instead of the median to
-  // preserve rare colors
-  int splitUnbalance =
-      GifIAbs((splitValue - rangeMin) - (rangeMax - splitValue));
-  if (splitUnbalance > (1536 >> treeLevel)) {
-    splitValue = rangeMin + (rangeMax - rangeMin) / 2;
-    subPixelsA = GifPartitionByMean(image, 0, numPixels, splitCom, splitValue);
-  }
-
-  // add the bottom node for the transparency index
-  if (treeNode == numColors / 2) {
-    subPixelsA = 0;
-    splitValue = 0;
-  }
-
+  int subPixelsA = GifSplitNode(image, numPixels, treeNode, treeLevel, pal);
   int subPixelsB = numPixels - subPixelsA;
-  pal->treeSplitElt[treeNode] = (uint8_t)splitCom;
-  pal->treeSplit[treeNode] = (uint8_t)splitValue;
 
   GifSplitPalette(image, subPixelsA, treeNode * 2, treeLevel + 1,
                   buildForDither, pal);
@@ -346,6 +417,53 @@ void GifSplitPalette(uint8_t* image, int numPixels, int treeNode, int treeLevel,
                   treeLevel + 1, buildForDither, pal);
 }
 
+// Builds the palette tree like GifSplitPalette, but hands the subtrees below
+// kGifParallelTreeLevel out as parallel tasks. Subtrees own disjoint pixel
+// ranges, tree nodes and palette entries, so the result is the same.
+void GifSplitPaletteParallel(uint8_t* image, int numPixels, bool buildForDither,
+                             GifPalette* pal) {
+  typedef struct {
+    uint8_t* image;
+    int numPixels;
+    int treeNode;
+    int treeLevel;
+  } GifSubtree;
+
+  const int maxSubtrees = 1 << kGifParallelTreeLevel;
+  GifSubtree subtrees[maxSubtrees];
+  GifSubtree children[maxSubtrees];
+  int numSubtrees = 1;
+  subtrees[0] = {image, numPixels, 1, 0};
+
+  int numColors = (1 << pal->bitDepth);
+  for (int level = 0; level < kGifParallelTreeLevel; ++level) {
+    int numChildren = 0;
+    for (int ii = 0; ii < numSubtrees; ++ii) {
+      const GifSubtree& node = subtrees[ii];
+      if (node.numPixels == 0 || node.treeNode >= numColors) {
+        children[numChildren++] = node;
+        continue;
+      }
+      int subPixelsA = GifSplitNode(node.image, node.numPixels, node.treeNode,
+                                    node.treeLevel, pal);
+      children[numChildren++] = {node.image, subPixelsA, node.treeNode * 2,
+                                 node.treeLevel + 1};
+      children[numChildren++] = {node.image + subPixelsA * 4,
+                                 node.numPixels - subPixelsA,
+                                 node.treeNode * 2 + 1, node.treeLevel + 1};
+    }
+    memcpy(subtrees, children, sizeof(GifSubtree) * (size_t)numChildren);
+    numSubtrees = numChildren;
+  }
+
+  auto splitSubtree = [&](int ii) {
+    GifSplitPalette(subtrees[ii].image, subtrees[ii].numPixels,
+                    subtrees[ii].treeNode, subtrees[ii].treeLevel,
+                    buildForDither, pal);
+  };
+  GIF_PARALLEL_FOR(numSubtrees, splitSubtree);
+}
+
 // Finds all pixels that have changed from the previous image and
 // moves them to the fromt of th buffer.
 // This allows us to build a palette optimized for the colors of the
@@ -389,7 +507,7 @@ void GifMakePalette(const uint8_t* lastFrame, const uint8_t* nextFrame,
   if (lastFrame)
     numPixels = GifPickChangedPixels(lastFrame, destroyableImage, numPixels);
 
-  GifSplitPalette(destroyableImage, numPixels, 1, 0, buildForDither, pPal);
+  GifSplitPaletteParallel(destroyableImage, numPixels, buildForDither, pPal);
 
   GIF_TEMP_FREE(destroyableImage);
 
@@ -403,7 +521,7 @@ void GifMakePalette(const uint8_t* lastFrame, const uint8_t* nextFrame,
 // Implements Floyd-Steinberg dithering, writes palette value to alpha
 void GifDitherImage(const uint8_t* lastFrame, const uint8_t* nextFrame,
                     uint8_t* outFrame, uint32_t width, uint32_t height,
-                    GifPalette* pPal) {
+                    GifPalette* pPal, GifColorCache& cache) {
   int numPixels = (int)(width * height);
 
   // quantPixels initially holds color*256 for all pixels
@@ -440,11 +558,8 @@ void GifDitherImage(const uint8_t* lastFrame, const uint8_t* nextFrame,
         continue;
       }
 
-      int32_t bestDiff = 1000000;
-      int32_t bestInd = kGifTransIndex;
-
       // Search the palete
-      GifGetClosestPaletteColor(pPal, rr, gg, bb, &bestInd, &bestDiff, 1);
+      int32_t bestInd = GifCachedPaletteColor(pPal, cache, rr, gg, bb);
 
       // Write the result to the temp buffer
       int32_t r_err = nextPix[0] - (int32_t)(pPal->r[bestInd]) * 256;
@@ -501,38 +616,92 @@ void GifDitherImage(const uint8_t* lastFrame, const uint8_t* nextFrame,
   GIF_TEMP_FREE(quantPixels);
 }
 
-// Picks palette colors for the image using simple thresholding, no dithering
+// Picks palette colors for the image using simple thresholding, no dithering.
+// Rows are independent and are processed in parallel bands.
 void GifThresholdImage(const uint8_t* lastFrame, const uint8_t* nextFrame,
                        uint8_t* outFrame, uint32_t width, uint32_t height,
-                       GifPalette* pPal) {
-  uint32_t numPixels = width * height;
-  for (uint32_t ii = 0; ii < numPixels; ++ii) {
-    // if a previous color is available, and it matches the current color,
-    // set the pixel to transparent
-    if (lastFrame && lastFrame[0] == nextFrame[0] &&
-        lastFrame[1] == nextFrame[1] && lastFrame[2] == nextFrame[2]) {
-      outFrame[0] = lastFrame[0];
-      outFrame[1] = lastFrame[1];
-      outFrame[2] = lastFrame[2];
-      outFrame[3] = kGifTransIndex;
-    } else {
+                       GifPalette* pPal, GifColorCache& cache) {
+  auto thresholdRows = [&](int band) {
+    uint32_t begin = (uint32_t)band * kGifRowsPerTask * width;
+    uint32_t end = (uint32_t)GifIMin(band * kGifRowsPerTask + kGifRowsPerTask,
+                                     (int)height) *
+                   width;
+    for (uint32_t ii = begin; ii < end; ++ii) {
+      const uint8_t* nextPix = nextFrame + ii * 4;
+      const uint8_t* lastPix = lastFrame ? lastFrame + ii * 4 : NULL;
+      uint8_t* outPix = outFrame + ii * 4;
+      // if a previous color is available, and it matches the current color,
+      // set the pixel to transparent
+      if (lastPix && lastPix[0] == nextPix[0] && lastPix[1] == nextPix[1] &&
+          lastPix[2] == nextPix[2]) {
+        outPix[0] = lastPix[0];
+        outPix[1] = lastPix[1];
+        outPix[2] = lastPix[2];
+        outPix[3] = kGifTransIndex;
+        continue;
+      }
       // palettize the pixel
-      int32_t bestDiff = 1000000;
-      int32_t bestInd = 1;
-      GifGetClosestPaletteColor(pPal, nextFrame[0], nextFrame[1], nextFrame[2],
-                                &bestInd, &bestDiff, 1);
+      int bestInd = GifCachedPaletteColor(pPal, cache, nextPix[0],
+                                          nextPix[1], nextPix[2]);
 
       // Write the resulting color to the output buffer
-      outFrame[0] = pPal->r[bestInd];
-      outFrame[1] = pPal->g[bestInd];
-      outFrame[2] = pPal->b[bestInd];
-      outFrame[3] = (uint8_t)bestInd;
+      outPix[0] = pPal->r[bestInd];
+      outPix[1] = pPal->g[bestInd];
+      outPix[2] = pPal->b[bestInd];
+      outPix[3] = (uint8_t)bestInd;
     }
+  };
+  GIF_PARALLEL_FOR(((int)height + kGifRowsPerTask - 1) / kGifRowsPerTask,
+                   thresholdRows);
+}
 
-    if (lastFrame) lastFrame += 4;
-    outFrame += 4;
-    nextFrame += 4;
-  }
+// Ordered dithering: every pixel gets the offset of its cell in an 8x8 Bayer
+// matrix before it is palettized. The offset depends only on the position, so
+// rows are processed in parallel bands, and a still pixel maps to the same
+// palette color as in the previous frame and is written as transparent.
+void GifOrderedDitherImage(const uint8_t* lastFrame, const uint8_t* nextFrame,
+                           uint8_t* outFrame, uint32_t width, uint32_t height,
+                           GifPalette* pPal, GifColorCache& cache) {
+  static const uint8_t bayer[8][8] = {
+      {0, 32, 8, 40, 2, 34, 10, 42},  {48, 16, 56, 24, 50, 18, 58, 26},
+      {12, 44, 4, 36, 14, 46, 6, 38}, {60, 28, 52, 20, 62, 30, 54, 22},
+      {3, 35, 11, 43, 1, 33, 9, 41},  {51, 19, 59, 27, 49, 17, 57, 25},
+      {15, 47, 7, 39, 13, 45, 5, 37}, {63, 31, 55, 23, 61, 29, 53, 21}};
+  // Offsets span about one palette step of a 256-color palette.
+  const int spread = 32;
+
+  auto ditherRows = [&](int band) {
+    uint32_t begin = (uint32_t)band * kGifRowsPerTask;
+    uint32_t end =
+        (uint32_t)GifIMin((int)begin + kGifRowsPerTask, (int)height);
+    for (uint32_t yy = begin; yy < end; ++yy) {
+      for (uint32_t xx = 0; xx < width; ++xx) {
+        uint32_t ii = yy * width + xx;
+        const uint8_t* nextPix = nextFrame + ii * 4;
+        uint8_t* outPix = outFrame + ii * 4;
+        int offset = (bayer[yy & 7][xx & 7] * 2 - 63) * spread / 128;
+        int bestInd = GifCachedPaletteColor(
+            pPal, cache, GifIMin(GifIMax(nextPix[0] + offset, 0), 255),
+            GifIMin(GifIMax(nextPix[1] + offset, 0), 255),
+            GifIMin(GifIMax(nextPix[2] + offset, 0), 255));
+
+        uint8_t r = pPal->r[bestInd];
+        uint8_t g = pPal->g[bestInd];
+        uint8_t b = pPal->b[bestInd];
+        // lastFrame and outFrame may be the same buffer, so the previous
+        // color is compared before the pixel is overwritten
+        const uint8_t* lastPix = lastFrame ? lastFrame + ii * 4 : NULL;
+        bool still =
+            lastPix && lastPix[0] == r && lastPix[1] == g && lastPix[2] == b;
+        outPix[0] = r;
+        outPix[1] = g;
+        outPix[2] = b;
+        outPix[3] = still ? (uint8_t)kGifTransIndex : (uint8_t)bestInd;
+      }
+    }
+  };
+  GIF_PARALLEL_FOR(((int)height + kGifRowsPerTask - 1) / kGifRowsPerTask,
+                   ditherRows);
 }
 
 // Simple structure to write out the LZW-compressed portion of the image
@@ -726,6 +895,7 @@ void GifWriteLzwImage(FILE* f, uint8_t* image, uint32_t left, uint32_t top,
 typedef struct {
   FILE* f;
   uint8_t* oldImage;
+  GifColorCache* colorCache;
   bool firstFrame;
 
   uint8_t padding[7];  // make padding explicit
@@ -752,6 +922,7 @@ bool GifBegin(GifWriter* writer, const char* filename, uint32_t width,
 
   // allocate
   writer->oldImage = (uint8_t*)GIF_MALLOC(width * height * 4);
+  writer->colorCache = new GifColorCache[1];
 
   fputs("GIF89a", writer->f);
 
@@ -800,22 +971,32 @@ bool GifBegin(GifWriter* writer, const char* filename, uint32_t width,
 // The GIFWriter should have been created by GIFBegin.
 // AFAIK, it is legal to use different bit depths for different frames of an
 // image - this may be handy to save bits in animations that don't change much.
+// dither is one of kGifDitherNone, kGifDitherFloydSteinberg (or true) and
+// kGifDitherOrdered.
 bool GifWriteFrame(GifWriter* writer, const uint8_t* image, uint32_t width,
                    uint32_t height, uint32_t delay, int bitDepth = 8,
-                   bool dither = false) {
+                   int dither = kGifDitherNone) {
   if (!writer->f) return false;
 
   const uint8_t* oldImage = writer->firstFrame ? NULL : writer->oldImage;
   writer->firstFrame = false;
 
-  GifPalette pal;
+  GifPalette pal = {};
   GifMakePalette((dither ? NULL : oldImage), image, width, height, bitDepth,
-                 dither, &pal);
-
-  if (dither)
-    GifDitherImage(oldImage, image, writer->oldImage, width, height, &pal);
+                 dither != kGifDitherNone, &pal);
+
+  // The palette changes every frame, so do the cached lookups.
+  GifColorCache& cache = *writer->colorCache;
+  GifClearColorCache(cache);
+  if (dither == kGifDitherOrdered)
+    GifOrderedDitherImage(oldImage, image, writer->oldImage, width, height,
+                          &pal, cache);
+  else if (dither)
+    GifDitherImage(oldImage, image, writer->oldImage, width, height, &pal,
+                   cache);
   else
-    GifThresholdImage(oldImage, image, writer->oldImage, width, height, &pal);
+    GifThresholdImage(oldImage, image, writer->oldImage, width, height, &pal,
+                      cache);
 
   GifWriteLzwImage(writer->f, writer->oldImage, 0, 0, width, height, delay,
                    &pal);
@@ -832,9 +1013,11 @@ bool GifEnd(GifWriter* writer) {
   fputc(0x3b, writer->f);  // end of file
   fclose(writer->f);
   GIF_FREE(writer->oldImage);
+  delete[] writer->colorCache;
 
   writer->f = NULL;
   writer->oldImage = NULL;
+  writer->colorCache = NULL;
 
   return true;
 }
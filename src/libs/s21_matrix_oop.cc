@@ -4,88 +4,238 @@
  */
 #include "s21_matrix_oop.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
 using namespace s21;
 
-Matrix::Matrix() {
-  this->rows_ = 1;
-  this->cols_ = 1;
-  this->matrix_ = new double *[1];
-  for (int i = 0; i < 1; i++) {
-    this->matrix_[i] = new double[1];
+namespace {
+
+/// Два числа double в векторном регистре (SSE2, NEON)
+using Double2 = double __attribute__((vector_size(16)));
+
+inline Double2 Load(const double *source) {
+  Double2 value;
+  std::memcpy(&value, source, sizeof(value));
+  return value;
+}
+
+inline void Store(double *destination, Double2 value) {
+  std::memcpy(destination, &value, sizeof(value));
+}
+
+/**
+ * Прибавляет к элементам j0..j1 строки результата c_row произведения строки
+ * a_row левого множителя на строки k0..k1 правого множителя b. Восемь
+ * элементов результата накапливаются в регистрах по всем k блока, поэтому
+ * каждый элемент суммируется в порядке возрастания k, как в тройном цикле.
+ */
+void MulBlockRow(const double *a_row, const double *b, int cols, int k0,
+                 int k1, int j0, int j1, double *c_row) {
+  int j = j0;
+  for (; j + 8 <= j1; j += 8) {
+    Double2 c0 = Load(c_row + j), c1 = Load(c_row + j + 2),
+            c2 = Load(c_row + j + 4), c3 = Load(c_row + j + 6);
+    for (int k = k0; k < k1; k++) {
+      const double *b_row = b + k * cols + j;
+      const double a_ik = a_row[k];
+      c0 += a_ik * Load(b_row);
+      c1 += a_ik * Load(b_row + 2);
+      c2 += a_ik * Load(b_row + 4);
+      c3 += a_ik * Load(b_row + 6);
+    }
+    Store(c_row + j, c0);
+    Store(c_row + j + 2, c1);
+    Store(c_row + j + 4, c2);
+    Store(c_row + j + 6, c3);
+  }
+  for (; j < j1; j++) {
+    double sum = c_row[j];
+    for (int k = k0; k < k1; k++) sum += a_row[k] * b[k * cols + j];
+    c_row[j] = sum;
   }
-  for (int i = 0; i < 1; i++) {
-    for (int j = 0; j < 1; j++) {
-      this->matrix_[i][j] = 0;
+}
+
+/**
+ * LU-разложение квадратной матрицы n x n на месте с выбором ведущего элемента
+ * по столбцу: P * A = L * U. Под диагональю остаются множители L (единичная
+ * диагональ L не хранится), на диагонали и выше - U. В perm записывается
+ * исходный номер строки для каждой строки результата, sign меняет знак при
+ * каждой перестановке. Возвращает false, если ведущий элемент столбца по
+ * модулю не превышает tolerance.
+ */
+bool LuDecompose(double *a, int n, int *perm, double *sign, double tolerance) {
+  bool regular = true;
+  for (int i = 0; i < n; i++) perm[i] = i;
+  for (int k = 0; k < n; k++) {
+    int pivot = k;
+    double max_val = fabs(a[k * n + k]);
+    for (int i = k + 1; i < n; i++) {
+      if (fabs(a[i * n + k]) > max_val) {
+        max_val = fabs(a[i * n + k]);
+        pivot = i;
+      }
+    }
+    if (max_val <= tolerance) {
+      regular = false;
+      continue;
+    }
+    if (pivot != k) {
+      std::swap_ranges(a + k * n, a + (k + 1) * n, a + pivot * n);
+      std::swap(perm[k], perm[pivot]);
+      *sign = -*sign;
+    }
+    const double *row_k = a + k * n;
+    for (int i = k + 1; i < n; i++) {
+      double *row_i = a + i * n;
+      const double factor = row_i[k] /= row_k[k];
+      for (int j = k + 1; j < n; j++) row_i[j] -= factor * row_k[j];
     }
   }
+  return regular;
 }
 
+/**
+ * Решает L * U * x = P * e_column прямой и обратной подстановкой и записывает
+ * x в столбец column матрицы inverse (n x n, по строкам).
+ */
+void LuSolveColumn(const double *lu, const int *perm, int n, int column,
+                   double *x, double *inverse) {
+  for (int i = 0; i < n; i++) {
+    double sum = perm[i] == column ? 1.0 : 0.0;
+    for (int k = 0; k < i; k++) sum -= lu[i * n + k] * x[k];
+    x[i] = sum;
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    double sum = x[i];
+    for (int k = i + 1; k < n; k++) sum -= lu[i * n + k] * x[k];
+    x[i] = sum / lu[i * n + i];
+  }
+  for (int i = 0; i < n; i++) inverse[i * n + column] = x[i];
+}
+
+/**
+ * Обращает аффинную матрицу 4x4 для векторов-строк (последний столбец равен
+ * (0, 0, 0, 1)) в замкнутом виде: линейная часть 3x3 обращается через
+ * присоединённую матрицу, перемещение t переходит в -t * L^-1. Возвращает
+ * false, если линейная часть вырождена: определитель сравнивается с
+ * произведением норм строк (оценкой Адамара), поэтому неравномерный масштаб
+ * строк не принимается за вырожденность.
+ */
+bool AffineInverse4x4(const double *m, double *inverse) {
+  const double c00 = m[5] * m[10] - m[6] * m[9];
+  const double c01 = m[6] * m[8] - m[4] * m[10];
+  const double c02 = m[4] * m[9] - m[5] * m[8];
+  const double det = m[0] * c00 + m[1] * c01 + m[2] * c02;
+  double bound = 3 * std::numeric_limits<double>::epsilon();
+  for (int i = 0; i < 3; i++) {
+    double row_scale = 0;
+    for (int j = 0; j < 3; j++) {
+      row_scale = std::max(row_scale, fabs(m[i * 4 + j]));
+    }
+    bound *= row_scale;
+  }
+  if (!(fabs(det) > bound)) return false;
+  const double r = 1.0 / det;
+  double l[9] = {c00 * r,
+                 (m[2] * m[9] - m[1] * m[10]) * r,
+                 (m[1] * m[6] - m[2] * m[5]) * r,
+                 c01 * r,
+                 (m[0] * m[10] - m[2] * m[8]) * r,
+                 (m[2] * m[4] - m[0] * m[6]) * r,
+                 c02 * r,
+                 (m[1] * m[8] - m[0] * m[9]) * r,
+                 (m[0] * m[5] - m[1] * m[4]) * r};
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) inverse[i * 4 + j] = l[i * 3 + j];
+    inverse[i * 4 + 3] = 0;
+  }
+  for (int j = 0; j < 3; j++) {
+    inverse[12 + j] =
+        -(m[12] * l[j] + m[13] * l[3 + j] + m[14] * l[6 + j]);
+  }
+  inverse[15] = 1;
+  return true;
+}
+
+}  // namespace
+
+Matrix::Matrix() { this->Allocate(1, 1); }
+
 Matrix::Matrix(int rows, int cols) {
   if (rows <= 0 || cols <= 0) {
     throw std::invalid_argument("ERROR");
   }
-  this->rows_ = rows;
-  this->cols_ = cols;
-  this->matrix_ = new double *[rows];
-  for (int i = 0; i < rows; i++) {
-    this->matrix_[i] = new double[cols];
-  }
-  for (int i = 0; i < rows; i++) {
-    for (int j = 0; j < cols; j++) {
-      this->matrix_[i][j] = 0;
+  this->Allocate(rows, cols);
+}
+
+Matrix::~Matrix() { this->Release(); }
+
+Matrix::Matrix(const Matrix &other) {
+  this->Allocate(other.rows_, other.cols_);
+  std::copy(other.matrix_, other.matrix_ + other.rows_ * other.cols_,
+            this->matrix_);
+}
+
+Matrix::Matrix(Matrix &&other) noexcept { this->Steal(other); }
+
+Matrix &Matrix::operator=(const Matrix &other) {
+  if (this != &other) {
+    if (this->rows_ * this->cols_ != other.rows_ * other.cols_) {
+      this->Release();
+      this->Allocate(other.rows_, other.cols_);
     }
+    this->rows_ = other.rows_;
+    this->cols_ = other.cols_;
+    std::copy(other.matrix_, other.matrix_ + other.rows_ * other.cols_,
+              this->matrix_);
   }
+  return *this;
 }
 
-Matrix::~Matrix() {
-  for (int i = 0; i < this->rows_; i++) {
-    delete[] this->matrix_[i];
+Matrix &Matrix::operator=(Matrix &&other) noexcept {
+  if (this != &other) {
+    this->Release();
+    this->Steal(other);
   }
-  delete[] this->matrix_;
+  return *this;
 }
 
-Matrix::Matrix(const Matrix &other) {
-  this->rows_ = other.rows_;
-  this->cols_ = other.cols_;
-  this->matrix_ = new double *[other.rows_];
-  for (int i = 0; i < other.rows_; i++) {
-    this->matrix_[i] = new double[other.cols_];
-  }
-  for (int i = 0; i < other.rows_; i++) {
-    for (int j = 0; j < other.cols_; j++) {
-      this->matrix_[i][j] = other.matrix_[i][j];
-    }
+void Matrix::Allocate(int rows, int cols) {
+  this->rows_ = rows;
+  this->cols_ = cols;
+  int size = rows * cols;
+  if (size <= kInlineSize) {
+    this->matrix_ = this->inline_;
+    std::fill(this->inline_, this->inline_ + size, 0.0);
+  } else {
+    this->matrix_ = new double[size]();
   }
 }
 
-Matrix::Matrix(Matrix &&other) {
-  this->rows_ = other.rows_;
-  this->cols_ = other.cols_;
-  this->matrix_ = other.matrix_;
-  other.matrix_ = nullptr;
-  other.rows_ = 0;
-  other.cols_ = 0;
+void Matrix::Release() {
+  if (this->matrix_ != this->inline_) delete[] this->matrix_;
+  this->matrix_ = this->inline_;
+  this->rows_ = 0;
+  this->cols_ = 0;
 }
 
-Matrix &Matrix::operator=(const Matrix &other) {
-  // if (other.matrix_ != this->matrix_) {
-  for (int i = 0; i < this->rows_; i++) {
-    delete[] this->matrix_[i];
-  }
-  delete[] this->matrix_;
-  //}
+void Matrix::Steal(Matrix &other) {
   this->rows_ = other.rows_;
   this->cols_ = other.cols_;
-  this->matrix_ = new double *[other.rows_];
-  for (int i = 0; i < other.rows_; i++) {
-    this->matrix_[i] = new double[other.cols_];
-  }
-  for (int i = 0; i < other.rows_; i++) {
-    for (int j = 0; j < other.cols_; j++) {
-      this->matrix_[i][j] = other.matrix_[i][j];
-    }
-  }
-  return *this;
+  if (other.matrix_ == other.inline_) {
+    std::copy(other.inline_, other.inline_ + other.rows_ * other.cols_,
+              this->inline_);
+    this->matrix_ = this->inline_;
+  } else {
+    this->matrix_ = other.matrix_;
+  }
+  other.matrix_ = other.inline_;
+  other.rows_ = 0;
+  other.cols_ = 0;
 }
 
 bool Matrix::operator==(const Matrix &other) { return EqMatrix(other); }
@@ -138,10 +288,8 @@ void Matrix::SumMatrix(const Matrix &other) {
   if (this->rows_ != other.rows_ || this->cols_ != other.cols_) {
     throw std::range_error("ERROR");
   }
-  for (int i = 0; i < this->rows_; i++) {
-    for (int j = 0; j < this->cols_; j++) {
-      this->matrix_[i][j] += other.matrix_[i][j];
-    }
+  for (int i = 0; i < this->rows_ * this->cols_; i++) {
+    this->matrix_[i] += other.matrix_[i];
   }
 }
 
@@ -149,18 +297,14 @@ void Matrix::SubMatrix(const Matrix &other) {
   if (this->rows_ != other.rows_ || this->cols_ != other.cols_) {
     throw std::range_error("ERROR");
   }
-  for (int i = 0; i < this->rows_; i++) {
-    for (int j = 0; j < this->cols_; j++) {
-      this->matrix_[i][j] -= other.matrix_[i][j];
-    }
+  for (int i = 0; i < this->rows_ * this->cols_; i++) {
+    this->matrix_[i] -= other.matrix_[i];
   }
 }
 
 void Matrix::MulNumber(const double number) {
-  for (int i = 0; i < this->rows_; i++) {
-    for (int j = 0; j < this->cols_; j++) {
-      this->matrix_[i][j] *= number;
-    }
+  for (int i = 0; i < this->rows_ * this->cols_; i++) {
+    this->matrix_[i] *= number;
   }
 }
 
@@ -169,15 +313,22 @@ void Matrix::MulMatrix(const Matrix &other) {
     throw std::range_error("ERROR");
   }
 
-  Matrix result(this->rows_, other.cols_);
-  for (int k = 0; k < this->cols_; k++) {
-    for (int i = 0; i < this->rows_; i++) {
-      for (int j = 0; j < other.cols_; j++) {
-        result.matrix_[i][j] += this->matrix_[i][k] * other.matrix_[k][j];
+  const int rows = this->rows_, inner = this->cols_, cols = other.cols_;
+  Matrix result(rows, cols);
+  for (int i0 = 0; i0 < rows; i0 += kBlockSize) {
+    const int i1 = std::min(i0 + kBlockSize, rows);
+    for (int k0 = 0; k0 < inner; k0 += kBlockSize) {
+      const int k1 = std::min(k0 + kBlockSize, inner);
+      for (int j0 = 0; j0 < cols; j0 += kBlockSize) {
+        const int j1 = std::min(j0 + kBlockSize, cols);
+        for (int i = i0; i < i1; i++) {
+          MulBlockRow(this->matrix_ + i * inner, other.matrix_, cols, k0, k1,
+                      j0, j1, result.matrix_ + i * cols);
+        }
       }
     }
   }
-  *this = result;
+  *this = std::move(result);
 }
 
 bool Matrix::EqMatrix(const Matrix &other) {
@@ -186,7 +337,7 @@ bool Matrix::EqMatrix(const Matrix &other) {
   if (this->rows_ == other.rows_ && this->cols_ == other.cols_) {
     for (int i = 0; i < this->rows_ && flag_eq == 0; i++) {
       for (int j = 0; j < this->cols_ && flag_eq == 0; j++) {
-        if (fabs(this->matrix_[i][j] - other.matrix_[i][j]) >= 1e-7) {
+        if (fabs((*this)(i, j) - other(i, j)) >= 1e-7) {
           flag_eq = 1;
         }
       }
@@ -202,14 +353,14 @@ double &Matrix::operator()(int i, int j) const {
   if (i >= this->rows_ || j >= this->cols_ || i < 0 || j < 0) {
     throw std::out_of_range("ERROR");
   }
-  return this->matrix_[i][j];
+  return this->matrix_[i * this->cols_ + j];
 }
 
 Matrix Matrix::Transpose() {
   Matrix result(this->cols_, this->rows_);
   for (int i = 0; i < this->cols_; i++) {
     for (int j = 0; j < this->rows_; j++) {
-      result.matrix_[i][j] = this->matrix_[j][i];
+      result(i, j) = (*this)(j, i);
     }
   }
 
@@ -220,13 +371,21 @@ Matrix Matrix::CalcComplements() {
   if (this->cols_ != this->rows_) {
     throw std::range_error("ERROR");
   }
-  Matrix M(this->rows_ - 1, this->cols_ - 1);
+  double determinant = this->Determinant();
   Matrix result(this->rows_, this->cols_);
+  if (determinant != 0.0 && this->rows_ > 1) {
+    // Для невырожденной матрицы алгебраические дополнения равны
+    // det(A) * (A^-1)^T, что вычисляется за O(n^3).
+    result = this->InverseMatrix().Transpose();
+    result.MulNumber(determinant);
+    return result;
+  }
+  Matrix M(this->rows_ - 1, this->cols_ - 1);
   for (int i = 0; i < this->rows_; i++) {
     for (int j = 0; j < this->cols_; j++) {
       M = this->CreateMinor(i, j);
 
-      result.matrix_[i][j] = M.Determinant() * powf(-1.0, i + j);
+      result(i, j) = M.Determinant() * powf(-1.0, i + j);
     }
   }
   return result;
@@ -236,37 +395,16 @@ double Matrix::Determinant() {
   if (this->cols_ != this->rows_) {
     throw std::range_error("ERROR");
   }
-  double result = 1;
-  double tmp = 0.0;
+  Matrix TMP(*this);
+  std::vector<int> perm(this->rows_);
   double sign = 1.0;
-  Matrix TMP(this->rows_, this->cols_);
+  LuDecompose(TMP.matrix_, this->rows_, perm.data(), &sign, 0.0);
+  double result = sign;
   for (int i = 0; i < this->rows_; i++) {
-    for (int j = 0; j < this->cols_; j++) {
-      TMP.matrix_[i][j] = this->matrix_[i][j];
-    }
-  }
-  for (int k = 0; k < this->cols_ - 1; k++) {
-    TMP.RawRearrange(k, &sign);
-    for (int i = 0; i < this->rows_; i++) {
-      tmp = TMP.matrix_[i][k] / TMP.matrix_[k][k];
-
-      for (int j = 0; j < TMP.cols_; j++) {
-        if (i > k && j >= k) {
-          TMP.matrix_[i][j] = TMP.matrix_[i][j] - tmp * TMP.matrix_[k][j];
-        }
-      }
-    }
+    result *= TMP.matrix_[i * this->cols_ + i];
   }
 
-  for (int i = 0; i < TMP.cols_; i++) {
-    result *= TMP.matrix_[i][i];
-  }
-
-  if (result != result)
-    result = 0;
-  else
-    result *= sign;
-
+  if (result != result) result = 0;
   if (fabs(result) < 1e-6) result = 0.0;
   return result;
 }
@@ -277,14 +415,14 @@ Matrix Matrix::CreateMinor(const int row_i, const int column_j) {
   for (int i = 0; i < this->rows_ - 1; i++) {
     for (int j = 0; j < this->cols_ - 1; j++) {
       if (i < row_i && j < column_j) {
-        result.matrix_[i][j] = this->matrix_[i][j];
+        result(i, j) = (*this)(i, j);
       } else if (i >= row_i && j < column_j) {
-        result.matrix_[i][j] = this->matrix_[i + 1][j];
+        result(i, j) = (*this)(i + 1, j);
       } else if (i < row_i && j >= column_j) {
-        result.matrix_[i][j] = this->matrix_[i][j + 1];
+        result(i, j) = (*this)(i, j + 1);
 
       } else if (i >= row_i && j >= column_j) {
-        result.matrix_[i][j] = this->matrix_[i + 1][j + 1];
+        result(i, j) = (*this)(i + 1, j + 1);
       }
     }
   }
@@ -292,40 +430,71 @@ Matrix Matrix::CreateMinor(const int row_i, const int column_j) {
 }
 
 Matrix Matrix::InverseMatrix() {
-  double determinant = 0.0;
-  determinant = this->Determinant();
-  if (determinant == 0.0) {
-    throw std::invalid_argument("ERROR");
+  if (this->cols_ != this->rows_) {
+    throw std::range_error("ERROR");
   }
-  Matrix result(this->rows_, this->cols_);
-  if (this->rows_ == this->cols_ && this->rows_ == 1) {
-    if (fabs(this->matrix_[0][0]) >= 1e-7) {
-      result.matrix_[0][0] = 1.0 / this->matrix_[0][0];
+  const int n = this->rows_;
+  Matrix result(n, n);
+  if (n == 4) {
+    const double *m = this->matrix_;
+    if (m[3] == 0 && m[7] == 0 && m[11] == 0 && m[15] == 1) {
+      if (!AffineInverse4x4(m, result.matrix_)) {
+        throw std::invalid_argument("ERROR");
+      }
+      return result;
+    }
+    if (m[12] == 0 && m[13] == 0 && m[14] == 0 && m[15] == 1) {
+      // Аффинная матрица для векторов-столбцов: обращается транспонированная.
+      Matrix transposed = this->Transpose();
+      if (!AffineInverse4x4(transposed.matrix_, result.matrix_)) {
+        throw std::invalid_argument("ERROR");
+      }
+      return result.Transpose();
     }
-
-  } else if (fabs(determinant) >= 1e-7 && this->rows_ == this->cols_) {
-    Matrix TMP = this->CalcComplements();
-    result = TMP.Transpose();
-    result.MulNumber(1.0 / determinant);
   }
 
+  // Строки приводятся к единичной максимальной норме (D * A), чтобы порог
+  // для ведущих элементов не зависел от масштаба отдельных строк. Обратная
+  // матрица восстанавливается как A^-1 = (D * A)^-1 * D.
+  Matrix lu(*this);
+  std::vector<double> row_scale(n);
+  for (int i = 0; i < n; i++) {
+    double *row = lu.matrix_ + i * n;
+    double scale = 0.0;
+    for (int j = 0; j < n; j++) scale = std::max(scale, fabs(row[j]));
+    if (!(scale > 0.0)) throw std::invalid_argument("ERROR");
+    for (int j = 0; j < n; j++) row[j] /= scale;
+    row_scale[i] = scale;
+  }
+  std::vector<int> perm(n);
+  double sign = 1.0;
+  double tolerance = n * std::numeric_limits<double>::epsilon();
+  if (!LuDecompose(lu.matrix_, n, perm.data(), &sign, tolerance)) {
+    throw std::invalid_argument("ERROR");
+  }
+  std::vector<double> column(n);
+  for (int j = 0; j < n; j++) {
+    LuSolveColumn(lu.matrix_, perm.data(), n, j, column.data(),
+                  result.matrix_);
+    for (int i = 0; i < n; i++) result.matrix_[i * n + j] /= row_scale[j];
+  }
   return result;
 }
 
 void Matrix::RawRearrange(int k, double *sign) {
   int i = 0;
-  double max_val = fabs(this->matrix_[k][k]);
+  double max_val = fabs((*this)(k, k));
   int raw_i = k;
   for (i = k; i < this->rows_; i++) {
-    if (fabs(this->matrix_[i][k]) > fabs(max_val)) {
-      max_val = fabs(this->matrix_[i][k]);
+    if (fabs((*this)(i, k)) > fabs(max_val)) {
+      max_val = fabs((*this)(i, k));
       raw_i = i;
     }
   }
-  if (max_val != fabs(this->matrix_[k][k])) {
-    double *ptr = this->matrix_[k];
-    this->matrix_[k] = this->matrix_[raw_i];
-    this->matrix_[raw_i] = ptr;
+  if (max_val != fabs((*this)(k, k))) {
+    double *row = this->matrix_ + k * this->cols_;
+    std::swap_ranges(row, row + this->cols_,
+                     this->matrix_ + raw_i * this->cols_);
     if (*sign == 1.0)
       *sign = -1.0;
     else
@@ -337,19 +506,12 @@ void Matrix::SetRows(int rows) {
   if (rows <= 0) {
     throw std::invalid_argument("ERROR");
   }
-  if (rows < this->rows_) {
-    for (int i = rows; i < this->rows_; i++) {
-      delete[] this->matrix_[i];
-    }
-    this->rows_ = rows;
-  } else if (rows > this->rows_) {
+  if (rows != this->rows_) {
     Matrix TMP(rows, this->cols_);
-    for (int i = 0; i < this->rows_; i++) {
-      for (int j = 0; j < this->cols_; j++) {
-        TMP.matrix_[i][j] = this->matrix_[i][j];
-      }
-    }
-    *this = TMP;
+    std::copy(this->matrix_,
+              this->matrix_ + std::min(rows, this->rows_) * this->cols_,
+              TMP.matrix_);
+    *this = std::move(TMP);
   }
 }
 
@@ -360,11 +522,11 @@ void Matrix::SetCols(int cols) {
   if (cols != this->cols_) {
     Matrix TMP(this->rows_, cols);
     for (int i = 0; i < this->rows_; i++) {
-      for (int j = 0; j < cols; j++) {
-        TMP.matrix_[i][j] = this->matrix_[i][j];
+      for (int j = 0; j < std::min(cols, this->cols_); j++) {
+        TMP(i, j) = (*this)(i, j);
       }
     }
-    *this = TMP;
+    *this = std::move(TMP);
   }
 }
 
@@ -7,6 +7,13 @@
  * матричные вычисления. Класс предоставляет удобный API для работы
  * с матрицами, включая стандартные арифметические операции, трансформации
  * и вычисления определителей и обратных матриц.
+ *
+ * Элементы хранятся в одном непрерывном буфере по строкам. Матрицы до 16
+ * элементов (в том числе 4x4) размещаются внутри объекта и не выделяют
+ * память в куче. Умножение выполняется блоками, помещающимися в кэш.
+ * Определитель и обратная матрица вычисляются через LU-разложение с выбором
+ * ведущего элемента за O(n^3); аффинные матрицы 4x4 обращаются в замкнутом
+ * виде.
  */
 
 #ifndef MATRIX_OOP_H
@@ -14,6 +21,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <stdexcept>
 
 namespace s21 {
 
@@ -29,9 +37,33 @@ namespace s21 {
  */
 class Matrix {
  protected:
-  int rows_;         ///< Количество строк матрицы
-  int cols_;         ///< Количество столбцов матрицы
-  double **matrix_;  ///< Указатель на двумерный массив элементов матрицы
+  /// Наибольшее число элементов, хранимых внутри объекта
+  static constexpr int kInlineSize = 16;
+  /// Размер блока умножения (строк и столбцов)
+  static constexpr int kBlockSize = 64;
+
+  int rows_;                      ///< Количество строк матрицы
+  int cols_;                      ///< Количество столбцов матрицы
+  double *matrix_;                ///< Элементы матрицы по строкам
+  double inline_[kInlineSize]{};  ///< Хранилище для небольших матриц
+
+  /**
+   * @brief Выделяет обнулённое хранилище под матрицу заданного размера
+   * @param rows Количество строк
+   * @param cols Количество столбцов
+   */
+  void Allocate(int rows, int cols);
+
+  /**
+   * @brief Освобождает хранилище, если оно выделено в куче
+   */
+  void Release();
+
+  /**
+   * @brief Забирает элементы другой матрицы, оставляя её пустой (0x0)
+   * @param other Матрица-источник
+   */
+  void Steal(Matrix &other);
 
  public:
   /**
@@ -59,7 +91,7 @@ class Matrix {
    * @brief Конструктор перемещения
    * @param other Объект для перемещения
    */
-  Matrix(Matrix &&other);
+  Matrix(Matrix &&other) noexcept;
 
   /**
    * @brief Деструктор
@@ -99,6 +131,13 @@ class Matrix {
    */
   Matrix &operator=(const Matrix &other);
 
+  /**
+   * @brief Оператор присваивания перемещением
+   * @param other Объект для перемещения
+   * @return Ссылка на текущий объект
+   */
+  Matrix &operator=(Matrix &&other) noexcept;
+
   /**
    * @brief Перегрузка оператора сравнения на равенство
    * @param other Ссылка на объект для сравнения
@@ -183,6 +222,11 @@ class Matrix {
 
   /**
    * @brief Умножает две матрицы
+   *
+   * Умножение выполняется блоками по `kBlockSize` строк и столбцов, внутренний
+   * цикл проходит строку результата подряд. Порядок суммирования для каждого
+   * элемента совпадает с обычным тройным циклом.
+   *
    * @param other Ссылка на вторую матрицу для умножения
    */
   void MulMatrix(const Matrix &other);
@@ -206,22 +250,38 @@ class Matrix {
   Matrix Transpose();
   /**
    * @brief Вычисляет матрицу обратных миноров
+   *
+   * Для невырожденной матрицы дополнения находятся как det(A) * (A^-1)^T,
+   * для вырожденной - через определители миноров.
+   *
    * @return Новый объект Matrix с матрицей обратных миноров
    */
   Matrix CalcComplements();
 
   /**
    * @brief Вычисляет определитель матрицы
+   *
+   * Определитель равен произведению диагонали U из LU-разложения с учётом
+   * знака перестановки строк. Значения меньше 1e-6 по модулю считаются нулём.
+   *
    * @return Значение определителя матрицы
-   * @throws std::range_error Если матрица не квадратная или имеет нулевой
-   * определитель
+   * @throws std::range_error Если матрица не квадратная
    */
   double Determinant();
 
   /**
    * @brief Вычисляет обратную матрицу
+   *
+   * Аффинная матрица 4x4 (последний столбец или последняя строка равны
+   * (0, 0, 0, 1)) обращается в замкнутом виде. Остальные матрицы обращаются
+   * решением n систем по LU-разложению с выбором ведущего элемента по
+   * столбцу. Вырожденность определяется по ведущим элементам относительно
+   * наибольшего элемента матрицы, а не по абсолютной величине определителя,
+   * поэтому обращаются и матрицы с малыми элементами.
+   *
    * @return Новый объект Matrix с обратной матрицей
-   * @throws std::invalid_argument Если определитель матрицы равен нулю
+   * @throws std::range_error Если матрица не квадратная
+   * @throws std::invalid_argument Если матрица вырождена
    */
   Matrix InverseMatrix();
   /**
@@ -4,22 +4,14 @@
  */
 
 #include "affinetransform.h"
+
+#include <algorithm>
+
+#include "../concurrency/thread_pool.h"
 using namespace s21;
 
 AffineTransform::AffineTransform() {
   vertices_ = nullptr;
-  TransformParametrs delta = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
-  MatrixBuilder *creator = new GeneralMatrixBuilder();
-  TransformMatrix *g_matrix = creator->FactoryMethod();
-  g_matrix->SetTransformMatrix(delta);
-  for (size_t i = 0; i < 4; i++) {
-    for (size_t j = 0; j < 4; j++) {
-      transform_matrix_(i, j) = (*g_matrix)(i, j);
-    }
-  }
-
-  delete g_matrix;
-  delete creator;
   translation_ = {0, 0, 0};
 }
 
@@ -32,6 +24,11 @@ void AffineTransform::AddVertices(std::vector<float> *vertices) {
   }
 }
 
+void AffineTransform::SetVertices(std::vector<float> *vertices) {
+  vertices_ = nullptr;
+  AddVertices(vertices);
+}
+
 std::vector<float> *AffineTransform::GetVertices() { return vertices_; }
 
 /*Delta AffineTransform::GetTranslation() {
@@ -44,65 +41,127 @@ void AffineTransform::SetTranslation(Delta &delta) {
   translation_.z += delta.z;
 }
 
-void AffineTransform::PrivateTransformVertices(TransformParametrs &delta) {
-  MatrixBuilder *creator = new GeneralMatrixBuilder();
-  TransformMatrix *g_matrix = creator->FactoryMethod();
-  g_matrix->SetTransformMatrix(delta);
-  for (size_t i = 0; i < 4; i++) {
-    for (size_t j = 0; j < 4; j++) {
-      transform_matrix_(i, j) = (*g_matrix)(i, j);
+void AffineTransform::PrivateTransformVertices(
+    TransformShape shape, std::vector<float> *destination) {
+  bool identity = transform_matrix_.IsIdentityMatrix();
+  if (mode_ == TransformMode::kRetained) {
+    if (!identity) model_matrix_.MulMatrix(transform_matrix_);
+    return;
+  }
+  if (destination != vertices_) {
+    destination->resize(vertices_->size());
+    if (identity) {
+      std::copy(vertices_->begin(), vertices_->end(), destination->begin());
     }
   }
+  if (!identity) {
+    ApplyMatrix(transform_matrix_.GetMatrix(), vertices_->data(),
+                destination->data(), vertices_->size() / 3, shape);
+  }
+  vertices_ = destination;
+}
 
-  delete g_matrix;
-  delete creator;
-  if (!this->transform_matrix_.IsIdentityMatrix()) {
-    for (size_t i = 0; i < (*vertices_).size() || i < 1; i += 3) {
-      Matrix m_vert(1, 4);
-
-      m_vert(0, 0) = (*vertices_)[i];
-      m_vert(0, 1) = (*vertices_)[i + 1];
-      m_vert(0, 2) = (*vertices_)[i + 2];
-      m_vert(0, 3) = 1;
-      m_vert.MulMatrix(transform_matrix_);
-
-      (*vertices_)[i] = m_vert(0, 0);
-      (*vertices_)[i + 1] = m_vert(0, 1);
-      (*vertices_)[i + 2] = m_vert(0, 2);
-    }
+void AffineTransform::ApplyMatrix(const Mat4 &matrix, const float *source,
+                                  float *destination, size_t count,
+                                  TransformShape shape) {
+  ThreadPool::Instance().ParallelFor(
+      count, kMinVerticesPerTask, [&](size_t begin, size_t end) {
+        TransformKernel::Transform(matrix, source + begin * 3,
+                                   destination + begin * 3, end - begin,
+                                   shape);
+      });
+}
+
+TransformShape AffineTransform::ShapeOf(const TransformParametrs &delta) {
+  bool scale = TransformMatrix::IsDelta(delta.scale);
+  bool move = TransformMatrix::IsDelta(delta.move);
+  bool rotation = TransformMatrix::IsDelta(delta.rotation);
+  if (move && !scale && !rotation) return TransformShape::kTranslate;
+  if (scale && !move && !rotation) return TransformShape::kScale;
+  if (rotation && !scale && !move) {
+    const Delta &r = delta.rotation;
+    if (!r.y && !r.z) return TransformShape::kRotateX;
+    if (!r.x && !r.z) return TransformShape::kRotateY;
+    if (!r.x && !r.y) return TransformShape::kRotateZ;
   }
+  return TransformShape::kGeneral;
+}
+
+void AffineTransform::SetMode(TransformMode mode) {
+  if (mode == TransformMode::kBaked && vertices_) BakeVertices();
+  mode_ = mode;
 }
 
-void AffineTransform::TranslateInLocal() {
-  if (IsTranslation()) {
-    TransformParametrs delta = {
-        {0, 0, 0},
-        {-translation_.x, -translation_.y, -translation_.z},
-        {0, 0, 0}};
-    PrivateTransformVertices(delta);
+TransformMode AffineTransform::GetMode() const { return mode_; }
+
+std::array<float, 16> AffineTransform::GetModelMatrix() const {
+  std::array<float, 16> result;
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      result[i * 4 + j] = static_cast<float>(model_matrix_(i, j));
+    }
   }
+  return result;
 }
 
-void AffineTransform::TranslateInGlobal() {
-  if (IsTranslation()) {
-    TransformParametrs delta = {
-        {0, 0, 0}, {translation_.x, translation_.y, translation_.z}, {0, 0, 0}};
-    PrivateTransformVertices(delta);
+std::vector<float> AffineTransform::GetTransformedVertices() const {
+  if (!vertices_) {
+    throw std::invalid_argument("Add vertices!\n");
   }
+  if (model_matrix_.IsIdentityMatrix()) return *vertices_;
+  std::vector<float> result(vertices_->size());
+  ApplyMatrix(model_matrix_.GetMatrix(), vertices_->data(), result.data(),
+              result.size() / 3);
+  return result;
 }
 
-void AffineTransform::TransformVertices(TransformParametrs &delta) {
+void AffineTransform::BakeVertices() {
   if (!vertices_) {
     throw std::invalid_argument("Add vertices!\n");
   }
-  TranslateInLocal();
+  if (!model_matrix_.IsIdentityMatrix()) {
+    ApplyMatrix(model_matrix_.GetMatrix(), vertices_->data(),
+                vertices_->data(), vertices_->size() / 3);
+    model_matrix_ = GeneralTransformMatrix();
+  }
+}
+
+void AffineTransform::Reset() {
+  model_matrix_ = GeneralTransformMatrix();
+  translation_ = {0, 0, 0};
+}
+
+GeneralTransformMatrix AffineTransform::InLocalCoordinates(
+    const GeneralTransformMatrix &step) const {
+  GeneralTransformMatrix result;
+  result.MulMatrix(MoveMatrixBuilder::Build(
+      {{0, 0, 0}, {-translation_.x, -translation_.y, -translation_.z}, {}}));
+  result.MulMatrix(step);
+  result.MulMatrix(MoveMatrixBuilder::Build(
+      {{0, 0, 0}, {translation_.x, translation_.y, translation_.z}, {}}));
+  return result;
+}
 
-  PrivateTransformVertices(delta);
+void AffineTransform::TransformVertices(TransformParametrs &delta) {
+  TransformVertices(delta, vertices_);
+}
 
-  TranslateInGlobal();
+void AffineTransform::TransformVertices(TransformParametrs &delta,
+                                        std::vector<float> *destination) {
+  if (!vertices_ || !destination) {
+    throw std::invalid_argument("Add vertices!\n");
+  }
+  transform_matrix_ = GeneralMatrixBuilder::Build(delta);
+  TransformShape shape = ShapeOf(delta);
+  // Перемещения перестановочны, поэтому T(-t) * T(m) * T(t) = T(m).
+  if (IsTranslation() && shape != TransformShape::kTranslate) {
+    transform_matrix_ = InLocalCoordinates(transform_matrix_);
+    shape = TransformShape::kGeneral;
+  }
+  PrivateTransformVertices(shape, destination);
   SetTranslation(delta.move);
 }
 
-bool AffineTransform::IsTranslation() {
+bool AffineTransform::IsTranslation() const {
   return translation_.x || translation_.y || translation_.z;
 }
\ No newline at end of file
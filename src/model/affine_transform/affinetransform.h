@@ -8,17 +8,31 @@
  * к вершинам 3D-моделей. Он использует параметры перемещения и трансформации
  * для изменения положения, масштаба и ориентации объектов в 3D-пространстве.
  *
+ * Преобразования применяются в одном из двух режимов (`TransformMode`):
+ * немедленно к вершинам либо накапливаются в матрице модели, которая
+ * применяется при отрисовке, а к вершинам — только по запросу.
  */
 
 #ifndef AFFINETRANSFORM_H
 #define AFFINETRANSFORM_H
 
+#include <array>
+#include <stdexcept>
 #include <vector>
 
 #include "factory.h"
+#include "transform_kernel.h"
 
 namespace s21 {
 
+/**
+ * @brief Режим применения преобразований
+ */
+enum class TransformMode {
+  kBaked,    ///< Каждое преобразование сразу переписывает вершины
+  kRetained  ///< Преобразования накапливаются в матрице модели
+};
+
 /**
  * @class AffineTransform
  * @brief Класс для выполнения афинных преобразований
@@ -29,18 +43,23 @@ namespace s21 {
 class AffineTransform {
  private:
   GeneralTransformMatrix transform_matrix_;  ///< Матрица преобразования
+  GeneralTransformMatrix model_matrix_;  ///< Накопленная матрица модели
   std::vector<float> *vertices_;             ///< Указатель на вектор вершин
   Delta translation_;                        ///< Параметры перемещения
+  TransformMode mode_ = TransformMode::kBaked;  ///< Режим преобразований
 
   /**
-   * @brief Приватный метод для перевода в глобальную систему координат
+   * @brief Переносит преобразование в локальную систему координат модели
+   *
+   * Возвращает T(-t) * M * T(t), где t - накопленное перемещение модели:
+   * вершины переводятся в начало координат, преобразуются и возвращаются
+   * обратно одним умножением на матрицу.
+   *
+   * @param step Матрица преобразования M
+   * @return Составная матрица
    */
-  void TranslateInGlobal();
-
-  /**
-   * @brief Приватный метод для перевода в локальную систему координат
-   */
-  void TranslateInLocal();
+  GeneralTransformMatrix InLocalCoordinates(
+      const GeneralTransformMatrix &step) const;
 
   /**
    * @brief Устанавливает параметры перемещения
@@ -49,17 +68,57 @@ class AffineTransform {
   void SetTranslation(Delta &delta);
 
   /**
-   * @brief Приватный метод для трансформации вершин
+   * @brief Применяет матрицу `transform_matrix_` к вершинам за один проход
+   *
+   * В режиме `kRetained` матрица преобразования домножается к матрице модели,
+   * а вершины не изменяются.
+   *
+   * @param shape Вид матрицы, выбирающий специализированное ядро
+   * @param destination Вектор для результата; становится текущим вектором
+   * вершин
+   */
+  void PrivateTransformVertices(TransformShape shape,
+                                std::vector<float> *destination);
+
+  /**
+   * @brief Применяет матрицу к вершинам
+   *
+   * Массив делится между потоками общего пула `ThreadPool`; модели меньше
+   * `kMinVerticesPerTask` вершин на поток обрабатываются в текущем потоке.
+   * Массивы `source` и `destination` могут совпадать.
+   *
+   * @param matrix Матрица преобразования 4x4
+   * @param source Исходные вершины
+   * @param destination Результат
+   * @param count Число вершин
+   * @param shape Вид матрицы, выбирающий специализированное ядро
+   */
+  static void ApplyMatrix(const Mat4 &matrix, const float *source,
+                          float *destination, size_t count,
+                          TransformShape shape = TransformShape::kGeneral);
+
+  /**
+   * @brief Определяет вид матрицы по параметрам трансформации
+   *
+   * Если изменена только одна составляющая (перемещение, масштаб или поворот
+   * вокруг одной оси), возвращается соответствующий специализированный вид.
+   *
    * @param delta Параметры трансформации
+   * @return Вид матрицы
+   */
+  static TransformShape ShapeOf(const TransformParametrs &delta);
+
+  /**
+   * Минимальное число вершин на поток при параллельном преобразовании
    */
-  void PrivateTransformVertices(TransformParametrs &delta);
+  static constexpr size_t kMinVerticesPerTask = 1 << 15;
 
   /**
    * @brief Проверяет была ли фигура сдвинута от начала координат
    * @return true, если фигура сдвинута от начала координат, false в противном
    * случае
    */
-  bool IsTranslation();
+  bool IsTranslation() const;
 
  public:
   /**
@@ -73,6 +132,15 @@ class AffineTransform {
    */
   void AddVertices(std::vector<float> *vertices);
 
+  /**
+   * @brief Заменяет вектор вершин для трансформации
+   *
+   * В отличие от `AddVertices` заменяет уже добавленный вектор.
+   *
+   * @param vertices Указатель на вектор вершин
+   */
+  void SetVertices(std::vector<float> *vertices);
+
   /**
    * @brief Трансформирует вектор вершин с учетом заданных параметров
    * трансформации
@@ -80,11 +148,68 @@ class AffineTransform {
    */
   void TransformVertices(TransformParametrs &delta);
 
+  /**
+   * @brief Трансформирует вершины в другой вектор
+   *
+   * Вершины читаются из текущего вектора, результат записывается в
+   * `destination`, который затем становится текущим вектором вершин. Так
+   * вершины можно преобразовать в свободный буфер за тот же один проход, не
+   * изменяя вектор, который ещё читают другие. В режиме `kRetained` вершины
+   * не изменяются и `destination` не используется.
+   *
+   * @param delta Параметры трансформации
+   * @param destination Вектор для результата
+   */
+  void TransformVertices(TransformParametrs &delta,
+                         std::vector<float> *destination);
+
   /**
    * @brief Получает указатель на вектор вершин
    * @return Указатель на вектор вершин
    */
   std::vector<float> *GetVertices();
+
+  /**
+   * @brief Устанавливает режим применения преобразований
+   *
+   * При переходе в режим `kBaked` накопленная матрица модели применяется к
+   * вершинам.
+   *
+   * @param mode Режим преобразований
+   */
+  void SetMode(TransformMode mode);
+
+  /**
+   * @brief Возвращает режим применения преобразований
+   * @return Режим преобразований
+   */
+  TransformMode GetMode() const;
+
+  /**
+   * @brief Возвращает накопленную матрицу модели
+   *
+   * Матрица записана по строкам для вершин-строк (v' = v * M), что совпадает
+   * с порядком по столбцам, принятым в OpenGL.
+   *
+   * @return 16 элементов матрицы модели
+   */
+  std::array<float, 16> GetModelMatrix() const;
+
+  /**
+   * @brief Возвращает копию вершин с применённой матрицей модели
+   * @return Преобразованные вершины
+   */
+  std::vector<float> GetTransformedVertices() const;
+
+  /**
+   * @brief Применяет матрицу модели к вершинам и сбрасывает её
+   */
+  void BakeVertices();
+
+  /**
+   * @brief Сбрасывает матрицу модели и накопленное перемещение
+   */
+  void Reset();
 };
 
 }  // namespace s21
@@ -12,7 +12,7 @@
 
 #include "factory.h"
 
-#include <iostream>
+#include <cmath>
 
 using namespace s21;
 
@@ -65,94 +65,15 @@ void RotationZTransformMatrix::SetTransformMatrix(TransformParametrs delta) {
 }
 
 void RotationTransformMatrix::SetTransformMatrix(TransformParametrs delta) {
-  MatrixBuilder *creator1 = new RotationXMatrixBuilder();
-  TransformMatrix *x_matrix = creator1->FactoryMethod();
-  x_matrix->SetTransformMatrix(delta);
-  this->MulMatrix(*x_matrix);
-  delete x_matrix;
-  delete creator1;
-
-  MatrixBuilder *creator2 = new RotationYMatrixBuilder();
-  TransformMatrix *y_matrix = creator2->FactoryMethod();
-  y_matrix->SetTransformMatrix(delta);
-  this->MulMatrix(*y_matrix);
-  delete y_matrix;
-  delete creator2;
-
-  MatrixBuilder *creator3 = new RotationZMatrixBuilder();
-  TransformMatrix *z_matrix = creator3->FactoryMethod();
-  z_matrix->SetTransformMatrix(delta);
-  this->MulMatrix(*z_matrix);
-  delete z_matrix;
-  delete creator3;
+  if (delta.rotation.x) MulMatrix(RotationXMatrixBuilder::Build(delta));
+  if (delta.rotation.y) MulMatrix(RotationYMatrixBuilder::Build(delta));
+  if (delta.rotation.z) MulMatrix(RotationZMatrixBuilder::Build(delta));
 }
 
 void GeneralTransformMatrix::SetTransformMatrix(TransformParametrs delta) {
-  if (IsDelta(delta.scale)) {
-    MatrixBuilder *creator = new ScaleMatrixBuilder();
-    TransformMatrix *s_matrix = creator->FactoryMethod();
-    s_matrix->SetTransformMatrix(delta);
-    this->MulMatrix(*s_matrix);
-    delete s_matrix;
-    delete creator;
-  }
-
-  if (IsDelta(delta.rotation)) {
-    MatrixBuilder *creator = new RotationMatrixBuilder();
-    TransformMatrix *r_matrix = creator->FactoryMethod();
-    r_matrix->SetTransformMatrix(delta);
-    this->MulMatrix(*r_matrix);
-    delete r_matrix;
-    delete creator;
-  }
-
-  if (IsDelta(delta.move)) {
-    MatrixBuilder *creator = new MoveMatrixBuilder();
-    TransformMatrix *m_matrix = creator->FactoryMethod();
-    m_matrix->SetTransformMatrix(delta);
-    this->MulMatrix(*m_matrix);
-    delete m_matrix;
-    delete creator;
-  }
-}
-
-TransformMatrix *MoveMatrixBuilder::FactoryMethod() {
-  return new MoveTransformMatrix();
-}
-
-TransformMatrix *ScaleMatrixBuilder::FactoryMethod() {
-  return new ScaleTransformMatrix();
-}
-
-TransformMatrix *RotationMatrixBuilder::FactoryMethod() {
-  return new RotationTransformMatrix();
-}
-
-TransformMatrix *RotationXMatrixBuilder::FactoryMethod() {
-  return new RotationXTransformMatrix();
-}
-TransformMatrix *RotationYMatrixBuilder::FactoryMethod() {
-  return new RotationYTransformMatrix();
-}
-TransformMatrix *RotationZMatrixBuilder::FactoryMethod() {
-  return new RotationZTransformMatrix();
-}
-
-TransformMatrix *GeneralMatrixBuilder::FactoryMethod() {
-  return new GeneralTransformMatrix();
+  if (IsDelta(delta.scale)) MulMatrix(ScaleMatrixBuilder::Build(delta));
+  if (IsDelta(delta.rotation)) MulMatrix(RotationMatrixBuilder::Build(delta));
+  if (IsDelta(delta.move)) MulMatrix(MoveMatrixBuilder::Build(delta));
 }
 
-bool TransformMatrix::IsIdentityMatrix() {
-  bool result = true;
-  for (size_t i = 0; i < 4; i++) {
-    for (size_t j = 0; j < 4; j++) {
-      if ((i == j && matrix_[i][j] == 1) || (i != j && matrix_[i][j] == 0))
-        continue;
-      else {
-        result = false;
-        return result;
-      }
-    }
-  }
-  return result;
-}
\ No newline at end of file
+bool TransformMatrix::IsIdentityMatrix() const { return matrix_.IsIdentity(); }
@@ -8,7 +8,7 @@
 
 #include <vector>
 
-#include "../../libs/s21_matrix_oop.h"
+#include "mat4.h"
 
 /**
  * @struct Delta
@@ -43,14 +43,17 @@ namespace s21 {
  *
  * Этот класс является базовой абстракцией для различных типов трансформаций.
  * Он наследуется другими классами для конкретных типов преобразований.
+ * Элементы хранятся в `Mat4` внутри объекта, без выделения памяти в куче.
  */
-class TransformMatrix : public s21::Matrix {
- private:
+class TransformMatrix {
+ protected:
+  Mat4 matrix_;  ///< Элементы матрицы трансформации
+
  public:
   /**
    * @brief Конструктор по умолчанию
    */
-  TransformMatrix() : s21::Matrix(4, 4) { this->SetIdentityMatrix(); };
+  TransformMatrix() : matrix_(Mat4::Identity()) {};
 
   /**
    * @brief Деструктор
@@ -79,7 +82,35 @@ class TransformMatrix : public s21::Matrix {
    * @brief Проверяет, является ли текущая матрица единичной
    * @return true, если матрица единична, false в противном случае
    */
-  bool IsIdentityMatrix();
+  bool IsIdentityMatrix() const;
+
+  /**
+   * @brief Доступ к элементу матрицы
+   * @param i Номер строки
+   * @param j Номер столбца
+   * @return Ссылка на элемент
+   */
+  double &operator()(int i, int j) { return matrix_(i, j); }
+
+  /**
+   * @brief Доступ к элементу константной матрицы
+   * @param i Номер строки
+   * @param j Номер столбца
+   * @return Значение элемента
+   */
+  double operator()(int i, int j) const { return matrix_(i, j); }
+
+  /**
+   * @brief Умножает матрицу справа на другую матрицу трансформации
+   * @param other Правый множитель
+   */
+  void MulMatrix(const TransformMatrix &other) { matrix_ *= other.matrix_; }
+
+  /**
+   * @brief Возвращает элементы матрицы
+   * @return Матрица 4x4
+   */
+  const Mat4 &GetMatrix() const { return matrix_; }
 };
 
 /**
@@ -211,6 +242,9 @@ class GeneralTransformMatrix : public TransformMatrix {
  *
  * Этот интерфейс определяет метод FactoryMethod(), который должен быть
  * реализован в подклассах для создания конкретных типов матриц трансформации.
+ * Он нужен, когда тип матрицы выбирается во время выполнения; внутри модели
+ * матрицы строятся статически через `MatrixBuilderT::Build` без выделения
+ * памяти.
  */
 class MatrixBuilder {
  public:
@@ -227,151 +261,75 @@ class MatrixBuilder {
 };
 
 /**
- * @class MoveMatrixBuilder
- * @brief Класс-строитель для создания матрицы перемещения
+ * @class MatrixBuilderT
+ * @brief Строитель матриц конкретного типа
  *
- * Этот класс наследуется от MatrixBuilder и реализует метод FactoryMethod(),
- * который создает экземпляр конкретного класса-наследника TransformMatrix,
- * специализирующегося на матрице перемещения.
+ * Реализует FactoryMethod() для динамического выбора типа матрицы и
+ * статический метод Build(), который возвращает готовую матрицу по значению.
+ * Тип матрицы известен на этапе компиляции, поэтому вызов
+ * SetTransformMatrix() не требует виртуальной диспетчеризации, а матрица
+ * размещается на стеке. Чтобы добавить новый вид трансформации, достаточно
+ * объявить наследника `TransformMatrix` и строитель
+ * `MatrixBuilderT<НовыйТип>`.
+ *
+ * @tparam Matrix Наследник TransformMatrix, создаваемый строителем
  */
-class MoveMatrixBuilder : public MatrixBuilder {
+template <typename Matrix>
+class MatrixBuilderT : public MatrixBuilder {
  public:
   /**
-   * @brief Метод-фабрика для создания матрицы перемещения
-   *
-   * Этот метод создает и возвращает экземпляр класса MoveTransformMatrix,
-   * который представляет собой матрицу перемещения.
-   *
-   * @return Указатель на новый экземпляр MoveTransformMatrix
+   * @brief Создаёт матрицу в куче
+   * @return Указатель на новый экземпляр Matrix
    */
-  TransformMatrix *FactoryMethod() override;
-  ~MoveMatrixBuilder() override {}
-};
+  TransformMatrix *FactoryMethod() override { return new Matrix(); }
 
-/**
- * @class ScaleMatrixBuilder
- * @brief Класс-строитель для создания матрицы масштабирования
- *
- * Реализует метод FactoryMethod() для создания экземпляра ScaleTransformMatrix.
- */
-class ScaleMatrixBuilder : public MatrixBuilder {
- public:
   /**
-   * @brief Метод-фабрика для создания матрицы масштабирования
-   *
-   * Создает и возвращает экземпляр ScaleTransformMatrix.
-   *
-   * @return Указатель на новый экземпляр ScaleTransformMatrix
+   * @brief Строит матрицу по параметрам трансформации без выделения памяти
+   * @param delta Параметры трансформации
+   * @return Матрица трансформации
    */
-  TransformMatrix *FactoryMethod() override;
-
-  ~ScaleMatrixBuilder() override {}
+  static Matrix Build(const TransformParametrs &delta) {
+    Matrix matrix;
+    matrix.Matrix::SetTransformMatrix(delta);
+    return matrix;
+  }
 };
 
 /**
- * @class RotationMatrixBuilder
- * @brief Класс-строитель для создания общей матрицы поворота
- *
- * Реализует метод FactoryMethod() для создания экземпляра
- * RotationTransformMatrix.
+ * @brief Строитель матрицы перемещения (MoveTransformMatrix)
  */
-class RotationMatrixBuilder : public MatrixBuilder {
- public:
-  /**
-   * @brief Метод-фабрика для создания общей матрицы поворота
-   *
-   * Создает и возвращает экземпляр RotationTransformMatrix.
-   *
-   * @return Указатель на новый экземпляр RotationTransformMatrix
-   */
-  TransformMatrix *FactoryMethod() override;
-
-  ~RotationMatrixBuilder() override {}
-};
+using MoveMatrixBuilder = MatrixBuilderT<MoveTransformMatrix>;
 
 /**
- * @class RotationXMatrixBuilder
- * @brief Класс-строитель для создания матрицы поворота вокруг оси X
- *
- * Реализует метод FactoryMethod() для создания экземпляра
- * RotationXTransformMatrix.
+ * @brief Строитель матрицы масштабирования (ScaleTransformMatrix)
  */
-class RotationXMatrixBuilder : public MatrixBuilder {
- public:
-  /**
-   * @brief Метод-фабрика для создания матрицы поворота вокруг оси X
-   *
-   * Создает и возвращает экземпляр RotationXTransformMatrix.
-   *
-   * @return Указатель на новый экземпляр RotationXTransformMatrix
-   */
-  TransformMatrix *FactoryMethod() override;
-
-  ~RotationXMatrixBuilder() override {}
-};
+using ScaleMatrixBuilder = MatrixBuilderT<ScaleTransformMatrix>;
 
 /**
- * @class RotationYMatrixBuilder
- * @brief Класс-строитель для создания матрицы поворота вокруг оси Y
- *
- * Реализует метод FactoryMethod() для создания экземпляра
- * RotationYTransformMatrix.
+ * @brief Строитель общей матрицы поворота (RotationTransformMatrix)
  */
-class RotationYMatrixBuilder : public MatrixBuilder {
- public:
-  /**
-   * @brief Метод-фабрика для создания матрицы поворота вокруг оси Y
-   *
-   * Создает и возвращает экземпляр RotationYTransformMatrix.
-   *
-   * @return Указатель на новый экземпляр RotationYTransformMatrix
-   */
-  TransformMatrix *FactoryMethod() override;
+using RotationMatrixBuilder = MatrixBuilderT<RotationTransformMatrix>;
 
-  ~RotationYMatrixBuilder() override {}
-};
+/**
+ * @brief Строитель матрицы поворота вокруг оси X (RotationXTransformMatrix)
+ */
+using RotationXMatrixBuilder = MatrixBuilderT<RotationXTransformMatrix>;
 
 /**
- * @class RotationZMatrixBuilder
- * @brief Класс-строитель для создания матрицы поворота вокруг оси Z
- *
- * Реализует метод FactoryMethod() для создания экземпляра
- * RotationZTransformMatrix.
+ * @brief Строитель матрицы поворота вокруг оси Y (RotationYTransformMatrix)
  */
-class RotationZMatrixBuilder : public MatrixBuilder {
- public:
-  /**
-   * @brief Метод-фабрика для создания матрицы поворота вокруг оси Z
-   *
-   * Создает и возвращает экземпляр RotationZTransformMatrix.
-   *
-   * @return Указатель на новый экземпляр RotationZTransformMatrix
-   */
-  TransformMatrix *FactoryMethod() override;
+using RotationYMatrixBuilder = MatrixBuilderT<RotationYTransformMatrix>;
 
-  ~RotationZMatrixBuilder() override {}
-};
+/**
+ * @brief Строитель матрицы поворота вокруг оси Z (RotationZTransformMatrix)
+ */
+using RotationZMatrixBuilder = MatrixBuilderT<RotationZTransformMatrix>;
 
 /**
- * @class GeneralMatrixBuilder
- * @brief Класс-строитель для создания общей матрицы трансформации
- *
- * Реализует метод FactoryMethod() для создания экземпляра
- * GeneralTransformMatrix.
+ * @brief Строитель общей матрицы трансформации (GeneralTransformMatrix)
  */
-class GeneralMatrixBuilder : public MatrixBuilder {
- public:
-  /**
-   * @brief Метод-фабрика для создания общей матрицы трансформации
-   *
-   * Создает и возвращает экземпляр GeneralTransformMatrix.
-   *
-   * @return Указатель на новый экземпляр GeneralTransformMatrix
-   */
-  TransformMatrix *FactoryMethod() override;
+using GeneralMatrixBuilder = MatrixBuilderT<GeneralTransformMatrix>;
 
-  ~GeneralMatrixBuilder() override {}
-};
 }  // namespace s21
 
 #endif  // FACTORY_H
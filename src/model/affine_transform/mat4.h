@@ -0,0 +1,197 @@
+/**
+ * @file mat4.h
+ * @brief Заголовочный файл для матрицы 4x4 и вектора из четырёх элементов
+ * фиксированного размера.
+ *
+ * `Mat4T` и `Vec4T` хранят элементы непрерывно в самом объекте, не выделяют
+ * память в куче и допускают вычисления на этапе компиляции (constexpr).
+ * Используются в аффинных преобразованиях вместо `s21::Matrix`.
+ *
+ * Принято соглашение о векторах-строках: v' = v * M, перемещение записано в
+ * последней строке матрицы. Поэтому элементы, записанные по строкам, совпадают
+ * с матрицей OpenGL, записанной по столбцам.
+ */
+#ifndef MAT4_H
+#define MAT4_H
+
+namespace s21 {
+
+/**
+ * @struct Vec4T
+ * @brief Вектор-строка из четырёх элементов
+ * @tparam T Тип элементов (float или double)
+ */
+template <typename T>
+struct Vec4T {
+  T x{};  ///< Координата X
+  T y{};  ///< Координата Y
+  T z{};  ///< Координата Z
+  T w{};  ///< Однородная координата
+};
+
+/**
+ * @class Mat4T
+ * @brief Матрица 4x4 с элементами, записанными по строкам
+ * @tparam T Тип элементов (float или double)
+ */
+template <typename T>
+class Mat4T {
+ public:
+  /**
+   * @brief Конструктор по умолчанию создаёт нулевую матрицу
+   */
+  constexpr Mat4T() : data_{} {}
+
+  /**
+   * @brief Возвращает единичную матрицу
+   * @return Единичная матрица
+   */
+  static constexpr Mat4T Identity() {
+    Mat4T result;
+    for (int i = 0; i < 4; ++i) result(i, i) = 1;
+    return result;
+  }
+
+  /**
+   * @brief Доступ к элементу матрицы
+   * @param i Номер строки
+   * @param j Номер столбца
+   * @return Ссылка на элемент
+   */
+  constexpr T &operator()(int i, int j) { return data_[i * 4 + j]; }
+
+  /**
+   * @brief Доступ к элементу константной матрицы
+   * @param i Номер строки
+   * @param j Номер столбца
+   * @return Значение элемента
+   */
+  constexpr const T &operator()(int i, int j) const {
+    return data_[i * 4 + j];
+  }
+
+  /**
+   * @brief Доступ к строке матрицы в виде matrix[i][j]
+   * @param i Номер строки
+   * @return Указатель на первый элемент строки
+   */
+  constexpr T *operator[](int i) { return data_ + i * 4; }
+
+  /**
+   * @brief Доступ к строке константной матрицы
+   * @param i Номер строки
+   * @return Указатель на первый элемент строки
+   */
+  constexpr const T *operator[](int i) const { return data_ + i * 4; }
+
+  /**
+   * @brief Произведение матриц
+   * @param other Правый множитель
+   * @return this * other
+   */
+  constexpr Mat4T operator*(const Mat4T &other) const {
+    Mat4T result;
+    for (int i = 0; i < 4; ++i) {
+      for (int k = 0; k < 4; ++k) {
+        T value = (*this)(i, k);
+        for (int j = 0; j < 4; ++j) result(i, j) += value * other(k, j);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @brief Умножение матрицы справа на другую матрицу
+   * @param other Правый множитель
+   * @return Ссылка на эту матрицу
+   */
+  constexpr Mat4T &operator*=(const Mat4T &other) {
+    *this = *this * other;
+    return *this;
+  }
+
+  /**
+   * @brief Поэлементное сравнение матриц
+   * @param other Матрица для сравнения
+   * @return true, если все элементы равны
+   */
+  constexpr bool operator==(const Mat4T &other) const {
+    for (int i = 0; i < 16; ++i) {
+      if (data_[i] != other.data_[i]) return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Проверяет, является ли матрица единичной
+   * @return true, если матрица единична
+   */
+  constexpr bool IsIdentity() const { return *this == Identity(); }
+
+  /**
+   * @brief Обращает аффинную матрицу в замкнутом виде
+   *
+   * Матрица должна иметь последний столбец (0, 0, 0, 1) и невырожденную
+   * линейную часть L (3x3). Обратная матрица состоит из L^-1, вычисленной
+   * через присоединённую матрицу, и перемещения -t * L^-1. Для вырожденной
+   * L элементы результата не определены (бесконечности или NaN).
+   *
+   * @return Обратная матрица
+   */
+  constexpr Mat4T AffineInverse() const {
+    const Mat4T &m = *this;
+    Mat4T result;
+    result(0, 0) = m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1);
+    result(0, 1) = m(0, 2) * m(2, 1) - m(0, 1) * m(2, 2);
+    result(0, 2) = m(0, 1) * m(1, 2) - m(0, 2) * m(1, 1);
+    result(1, 0) = m(1, 2) * m(2, 0) - m(1, 0) * m(2, 2);
+    result(1, 1) = m(0, 0) * m(2, 2) - m(0, 2) * m(2, 0);
+    result(1, 2) = m(0, 2) * m(1, 0) - m(0, 0) * m(1, 2);
+    result(2, 0) = m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0);
+    result(2, 1) = m(0, 1) * m(2, 0) - m(0, 0) * m(2, 1);
+    result(2, 2) = m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+    T det = m(0, 0) * result(0, 0) + m(0, 1) * result(1, 0) +
+            m(0, 2) * result(2, 0);
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) result(i, j) /= det;
+    }
+    for (int j = 0; j < 3; ++j) {
+      result(3, j) = -(m(3, 0) * result(0, j) + m(3, 1) * result(1, j) +
+                       m(3, 2) * result(2, j));
+    }
+    result(3, 3) = 1;
+    return result;
+  }
+
+  /**
+   * @brief Возвращает указатель на элементы, записанные по строкам
+   * @return Указатель на 16 элементов
+   */
+  constexpr const T *Data() const { return data_; }
+
+ private:
+  T data_[16];  ///< Элементы матрицы по строкам
+};
+
+/**
+ * @brief Умножение вектора-строки на матрицу
+ * @param v Вектор-строка
+ * @param m Матрица
+ * @return v * m
+ */
+template <typename T>
+constexpr Vec4T<T> operator*(const Vec4T<T> &v, const Mat4T<T> &m) {
+  return {v.x * m(0, 0) + v.y * m(1, 0) + v.z * m(2, 0) + v.w * m(3, 0),
+          v.x * m(0, 1) + v.y * m(1, 1) + v.z * m(2, 1) + v.w * m(3, 1),
+          v.x * m(0, 2) + v.y * m(1, 2) + v.z * m(2, 2) + v.w * m(3, 2),
+          v.x * m(0, 3) + v.y * m(1, 3) + v.z * m(2, 3) + v.w * m(3, 3)};
+}
+
+using Mat4 = Mat4T<double>;   ///< Матрица 4x4 двойной точности
+using Mat4f = Mat4T<float>;   ///< Матрица 4x4 одинарной точности
+using Vec4 = Vec4T<double>;   ///< Вектор двойной точности
+using Vec4f = Vec4T<float>;   ///< Вектор одинарной точности
+
+}  // namespace s21
+
+#endif  // MAT4_H
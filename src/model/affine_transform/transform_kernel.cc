@@ -0,0 +1,382 @@
+/**
+ * @file transform_kernel.cc
+ * @brief Реализация класса TransformKernel.
+ */
+
+#include "transform_kernel.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define S21_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+
+namespace {
+
+void TransformScalar(const Mat4& m, const float* source, float* destination,
+                     std::size_t count) {
+  for (std::size_t i = 0; i < count * 3; i += 3) {
+    double x = source[i], y = source[i + 1], z = source[i + 2];
+    destination[i] =
+        static_cast<float>(x * m(0, 0) + y * m(1, 0) + z * m(2, 0) + m(3, 0));
+    destination[i + 1] =
+        static_cast<float>(x * m(0, 1) + y * m(1, 1) + z * m(2, 1) + m(3, 1));
+    destination[i + 2] =
+        static_cast<float>(x * m(0, 2) + y * m(1, 2) + z * m(2, 2) + m(3, 2));
+  }
+}
+
+// Перемещение и масштаб меняют каждую координату независимо, поэтому массив
+// обрабатывается как поток чисел с повторяющимся через три элемента шаблоном
+// слагаемых или множителей. Элементы матриц этих видов точно представимы в
+// float, поэтому вычисление в float даёт тот же результат, что и общая
+// реализация.
+template <TransformShape kShape>
+float DiagonalFactor(const Mat4& m, int axis) {
+  static_assert(kShape == TransformShape::kTranslate ||
+                    kShape == TransformShape::kScale,
+                "Diagonal kernel supports translation and scaling only");
+  return static_cast<float>(kShape == TransformShape::kScale ? m(axis, axis)
+                                                             : m(3, axis));
+}
+
+template <TransformShape kShape>
+void DiagonalScalar(const Mat4& m, const float* source, float* destination,
+                    std::size_t size) {
+  const float factor[3] = {DiagonalFactor<kShape>(m, 0),
+                           DiagonalFactor<kShape>(m, 1),
+                           DiagonalFactor<kShape>(m, 2)};
+  for (std::size_t i = 0; i < size; ++i) {
+    if constexpr (kShape == TransformShape::kScale) {
+      destination[i] = source[i] * factor[i % 3];
+    } else {
+      destination[i] = source[i] + factor[i % 3];
+    }
+  }
+}
+
+// Поворот вокруг оси меняет только две координаты a и b; третья копируется.
+template <int kA, int kB>
+void RotationScalar(const Mat4& m, const float* source, float* destination,
+                    std::size_t count) {
+  constexpr int kKeep = 3 - kA - kB;
+  const double aa = m(kA, kA), ba = m(kB, kA), ab = m(kA, kB), bb = m(kB, kB);
+  for (std::size_t i = 0; i < count * 3; i += 3) {
+    double a = source[i + kA], b = source[i + kB];
+    destination[i + kA] = static_cast<float>(a * aa + b * ba);
+    destination[i + kB] = static_cast<float>(a * ab + b * bb);
+    destination[i + kKeep] = source[i + kKeep];
+  }
+}
+
+#ifdef S21_X86_KERNELS
+
+// Четыре вершины [x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3] переставляются в
+// [x0 x1 x2 x3] [y0 y1 y2 y3] [z0 z1 z2 z3] и обратно.
+__attribute__((target("sse2"))) inline void Deinterleave(__m128 a, __m128 b,
+                                                         __m128 c, __m128& x,
+                                                         __m128& y,
+                                                         __m128& z) {
+  x = _mm_shuffle_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 0, 0)),
+                     _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+  y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                     _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+  z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+                     _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+__attribute__((target("sse2"))) inline void Interleave(__m128 x, __m128 y,
+                                                       __m128 z, __m128& a,
+                                                       __m128& b, __m128& c) {
+  a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)),
+                     _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+  b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+                     _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+  c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+                     _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+__attribute__((target("sse2"))) inline __m128d Column(__m128d x, __m128d y,
+                                                      __m128d z,
+                                                      const __m128d* c) {
+  return _mm_add_pd(
+      _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, c[0]), _mm_mul_pd(y, c[1])),
+                 _mm_mul_pd(z, c[2])),
+      c[3]);
+}
+
+__attribute__((target("sse2"))) void TransformSse2(const Mat4& m,
+                                                   const float* source,
+                                                   float* destination,
+                                                   std::size_t count) {
+  __m128d c[3][4];
+  for (int j = 0; j < 3; ++j) {
+    for (int r = 0; r < 4; ++r) c[j][r] = _mm_set1_pd(m(r, j));
+  }
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const float* in = source + i * 3;
+    __m128 x, y, z, out[3];
+    Deinterleave(_mm_loadu_ps(in), _mm_loadu_ps(in + 4), _mm_loadu_ps(in + 8),
+                 x, y, z);
+    __m128d x_lo = _mm_cvtps_pd(x), x_hi = _mm_cvtps_pd(_mm_movehl_ps(x, x));
+    __m128d y_lo = _mm_cvtps_pd(y), y_hi = _mm_cvtps_pd(_mm_movehl_ps(y, y));
+    __m128d z_lo = _mm_cvtps_pd(z), z_hi = _mm_cvtps_pd(_mm_movehl_ps(z, z));
+    for (int j = 0; j < 3; ++j) {
+      out[j] = _mm_movelh_ps(_mm_cvtpd_ps(Column(x_lo, y_lo, z_lo, c[j])),
+                             _mm_cvtpd_ps(Column(x_hi, y_hi, z_hi, c[j])));
+    }
+    __m128 a, b, d;
+    Interleave(out[0], out[1], out[2], a, b, d);
+    float* result = destination + i * 3;
+    _mm_storeu_ps(result, a);
+    _mm_storeu_ps(result + 4, b);
+    _mm_storeu_ps(result + 8, d);
+  }
+  TransformScalar(m, source + i * 3, destination + i * 3, count - i);
+}
+
+__attribute__((target("avx2"))) void TransformAvx2(const Mat4& m,
+                                                   const float* source,
+                                                   float* destination,
+                                                   std::size_t count) {
+  __m256d c[3][4];
+  for (int j = 0; j < 3; ++j) {
+    for (int r = 0; r < 4; ++r) c[j][r] = _mm256_set1_pd(m(r, j));
+  }
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const float* in = source + i * 3;
+    __m128 x, y, z, out[3];
+    Deinterleave(_mm_loadu_ps(in), _mm_loadu_ps(in + 4), _mm_loadu_ps(in + 8),
+                 x, y, z);
+    __m256d xd = _mm256_cvtps_pd(x), yd = _mm256_cvtps_pd(y),
+            zd = _mm256_cvtps_pd(z);
+    for (int j = 0; j < 3; ++j) {
+      __m256d sum = _mm256_add_pd(
+          _mm256_add_pd(
+              _mm256_add_pd(_mm256_mul_pd(xd, c[j][0]),
+                            _mm256_mul_pd(yd, c[j][1])),
+              _mm256_mul_pd(zd, c[j][2])),
+          c[j][3]);
+      out[j] = _mm256_cvtpd_ps(sum);
+    }
+    __m128 a, b, d;
+    Interleave(out[0], out[1], out[2], a, b, d);
+    float* result = destination + i * 3;
+    _mm_storeu_ps(result, a);
+    _mm_storeu_ps(result + 4, b);
+    _mm_storeu_ps(result + 8, d);
+  }
+  TransformScalar(m, source + i * 3, destination + i * 3, count - i);
+}
+
+// Варианты с нулевой маской используются вместо _mm512_cvtps_pd и
+// _mm512_cvtpd_ps: у тех GCC 12 выдаёт ложное предупреждение о
+// неинициализированном значении.
+__attribute__((target("avx512f"))) inline __m512d Widen(__m128 lo,
+                                                        __m128 hi) {
+  __m256 both = _mm256_insertf128_ps(
+      _mm256_insertf128_ps(_mm256_setzero_ps(), lo, 0), hi, 1);
+  return _mm512_maskz_cvtps_pd(0xFF, both);
+}
+
+__attribute__((target("avx512f"))) void TransformAvx512(const Mat4& m,
+                                                        const float* source,
+                                                        float* destination,
+                                                        std::size_t count) {
+  __m512d c[3][4];
+  for (int j = 0; j < 3; ++j) {
+    for (int r = 0; r < 4; ++r) c[j][r] = _mm512_set1_pd(m(r, j));
+  }
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const float* in = source + i * 3;
+    __m128 x[2], y[2], z[2];
+    for (int half = 0; half < 2; ++half) {
+      const float* block = in + half * 12;
+      Deinterleave(_mm_loadu_ps(block), _mm_loadu_ps(block + 4),
+                   _mm_loadu_ps(block + 8), x[half], y[half], z[half]);
+    }
+    __m512d xd = Widen(x[0], x[1]), yd = Widen(y[0], y[1]),
+            zd = Widen(z[0], z[1]);
+    __m128 out[2][3];
+    for (int j = 0; j < 3; ++j) {
+      __m512d sum = _mm512_add_pd(
+          _mm512_add_pd(
+              _mm512_add_pd(_mm512_mul_pd(xd, c[j][0]),
+                            _mm512_mul_pd(yd, c[j][1])),
+              _mm512_mul_pd(zd, c[j][2])),
+          c[j][3]);
+      __m256 narrow = _mm512_maskz_cvtpd_ps(0xFF, sum);
+      out[0][j] = _mm256_castps256_ps128(narrow);
+      out[1][j] = _mm256_extractf128_ps(narrow, 1);
+    }
+    for (int half = 0; half < 2; ++half) {
+      __m128 a, b, d;
+      Interleave(out[half][0], out[half][1], out[half][2], a, b, d);
+      float* result = destination + i * 3 + half * 12;
+      _mm_storeu_ps(result, a);
+      _mm_storeu_ps(result + 4, b);
+      _mm_storeu_ps(result + 8, d);
+    }
+  }
+  TransformScalar(m, source + i * 3, destination + i * 3, count - i);
+}
+
+// Восемь вершин (24 числа) занимают три регистра AVX; шаблон слагаемых или
+// множителей повторяется с тем же периодом.
+template <TransformShape kShape>
+__attribute__((target("avx2"))) void DiagonalAvx2(const Mat4& m,
+                                                  const float* source,
+                                                  float* destination,
+                                                  std::size_t count) {
+  alignas(32) float pattern[24];
+  for (int j = 0; j < 24; ++j) pattern[j] = DiagonalFactor<kShape>(m, j % 3);
+  __m256 factor[3] = {_mm256_load_ps(pattern), _mm256_load_ps(pattern + 8),
+                      _mm256_load_ps(pattern + 16)};
+  std::size_t size = count * 3, i = 0;
+  for (; i + 24 <= size; i += 24) {
+    for (int j = 0; j < 3; ++j) {
+      __m256 value = _mm256_loadu_ps(source + i + j * 8);
+      if constexpr (kShape == TransformShape::kScale) {
+        value = _mm256_mul_ps(value, factor[j]);
+      } else {
+        value = _mm256_add_ps(value, factor[j]);
+      }
+      _mm256_storeu_ps(destination + i + j * 8, value);
+    }
+  }
+  DiagonalScalar<kShape>(m, source + i, destination + i, size - i);
+}
+
+template <int kA, int kB>
+__attribute__((target("avx2"))) void RotationAvx2(const Mat4& m,
+                                                  const float* source,
+                                                  float* destination,
+                                                  std::size_t count) {
+  const __m256d aa = _mm256_set1_pd(m(kA, kA)), ba = _mm256_set1_pd(m(kB, kA));
+  const __m256d ab = _mm256_set1_pd(m(kA, kB)), bb = _mm256_set1_pd(m(kB, kB));
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const float* in = source + i * 3;
+    __m128 v[3];
+    Deinterleave(_mm_loadu_ps(in), _mm_loadu_ps(in + 4), _mm_loadu_ps(in + 8),
+                 v[0], v[1], v[2]);
+    __m256d a = _mm256_cvtps_pd(v[kA]), b = _mm256_cvtps_pd(v[kB]);
+    v[kA] = _mm256_cvtpd_ps(
+        _mm256_add_pd(_mm256_mul_pd(a, aa), _mm256_mul_pd(b, ba)));
+    v[kB] = _mm256_cvtpd_ps(
+        _mm256_add_pd(_mm256_mul_pd(a, ab), _mm256_mul_pd(b, bb)));
+    __m128 out0, out1, out2;
+    Interleave(v[0], v[1], v[2], out0, out1, out2);
+    float* result = destination + i * 3;
+    _mm_storeu_ps(result, out0);
+    _mm_storeu_ps(result + 4, out1);
+    _mm_storeu_ps(result + 8, out2);
+  }
+  RotationScalar<kA, kB>(m, source + i * 3, destination + i * 3, count - i);
+}
+
+#endif  // S21_X86_KERNELS
+
+template <TransformShape kShape>
+void TransformDiagonal(const Mat4& m, const float* source, float* destination,
+                       std::size_t count, SimdLevel level) {
+#ifdef S21_X86_KERNELS
+  if (level >= SimdLevel::kAvx2) {
+    DiagonalAvx2<kShape>(m, source, destination, count);
+    return;
+  }
+#endif
+  (void)level;
+  DiagonalScalar<kShape>(m, source, destination, count * 3);
+}
+
+template <int kA, int kB>
+void TransformRotation(const Mat4& m, const float* source, float* destination,
+                       std::size_t count, SimdLevel level) {
+#ifdef S21_X86_KERNELS
+  if (level >= SimdLevel::kAvx2) {
+    RotationAvx2<kA, kB>(m, source, destination, count);
+    return;
+  }
+#endif
+  (void)level;
+  RotationScalar<kA, kB>(m, source, destination, count);
+}
+
+}  // namespace
+
+void TransformKernel::Transform(const Mat4& matrix, const float* source,
+                                float* destination, std::size_t count) {
+  Transform(matrix, source, destination, count, SimdLevel::kAvx512);
+}
+
+void TransformKernel::Transform(const Mat4& matrix, const float* source,
+                                float* destination, std::size_t count,
+                                SimdLevel level) {
+  static const SimdLevel supported = DetectLevel();
+  if (level > supported) level = supported;
+  switch (level) {
+#ifdef S21_X86_KERNELS
+    case SimdLevel::kAvx512:
+      TransformAvx512(matrix, source, destination, count);
+      return;
+    case SimdLevel::kAvx2:
+      TransformAvx2(matrix, source, destination, count);
+      return;
+    case SimdLevel::kSse2:
+      TransformSse2(matrix, source, destination, count);
+      return;
+#endif
+    default:
+      TransformScalar(matrix, source, destination, count);
+  }
+}
+
+void TransformKernel::Transform(const Mat4& matrix, const float* source,
+                                float* destination, std::size_t count,
+                                TransformShape shape) {
+  static const SimdLevel level = DetectLevel();
+  switch (shape) {
+    case TransformShape::kTranslate:
+      TransformDiagonal<TransformShape::kTranslate>(matrix, source,
+                                                    destination, count, level);
+      return;
+    case TransformShape::kScale:
+      TransformDiagonal<TransformShape::kScale>(matrix, source, destination,
+                                                count, level);
+      return;
+    case TransformShape::kRotateX:
+      TransformRotation<1, 2>(matrix, source, destination, count, level);
+      return;
+    case TransformShape::kRotateY:
+      TransformRotation<0, 2>(matrix, source, destination, count, level);
+      return;
+    case TransformShape::kRotateZ:
+      TransformRotation<0, 1>(matrix, source, destination, count, level);
+      return;
+    default:
+      Transform(matrix, source, destination, count);
+  }
+}
+
+SimdLevel TransformKernel::DetectLevel() {
+#ifdef S21_X86_KERNELS
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return SimdLevel::kAvx512;
+  if (__builtin_cpu_supports("avx2")) return SimdLevel::kAvx2;
+  if (__builtin_cpu_supports("sse2")) return SimdLevel::kSse2;
+#endif
+  return SimdLevel::kScalar;
+}
+
+}  // namespace s21
@@ -0,0 +1,115 @@
+/**
+ * @file transform_kernel.h
+ * @brief Заголовочный файл для векторизованного преобразования вершин.
+ *
+ * `TransformKernel` умножает массив вершин xyz (по три float подряд) на
+ * матрицу 4x4 векторами-строками. Реализации для SSE2, AVX2 и AVX-512
+ * обрабатывают по 4 или 8 вершин за шаг; набор инструкций выбирается при
+ * первом вызове по возможностям процессора. На других архитектурах и для
+ * остатка массива используется скалярная реализация.
+ *
+ * Для преобразований, затрагивающих одну составляющую (перемещение, масштаб
+ * или поворот вокруг одной оси), есть специализированные ядра
+ * (`TransformShape`): перемещение и масштаб сводятся к трём сложениям или
+ * умножениям на вершину, поворот — к преобразованию двух координат.
+ *
+ * Все реализации вычисляют x * m0j + y * m1j + z * m2j + m3j в double в одном
+ * и том же порядке, поэтому их результаты побитово совпадают со скалярной
+ * реализацией. Если компилятор заменит умножение и сложение слитной операцией
+ * (FMA, например при -march=native), результаты могут отличаться на одну
+ * единицу последнего разряда float.
+ */
+#ifndef TRANSFORM_KERNEL_H
+#define TRANSFORM_KERNEL_H
+
+#include <cstddef>
+
+#include "mat4.h"
+
+namespace s21 {
+
+/**
+ * @brief Набор векторных инструкций, используемый для преобразования
+ */
+enum class SimdLevel {
+  kScalar,  ///< Скалярная реализация
+  kSse2,    ///< SSE2, 4 вершины за шаг
+  kAvx2,    ///< AVX2, 4 вершины за шаг в 256-битных регистрах
+  kAvx512   ///< AVX-512F, 8 вершин за шаг
+};
+
+/**
+ * @brief Вид матрицы преобразования, определяющий специализированное ядро
+ */
+enum class TransformShape {
+  kGeneral,    ///< Произвольная аффинная матрица
+  kTranslate,  ///< Только перемещение (строка 3)
+  kScale,      ///< Только масштаб по осям (диагональ)
+  kRotateX,    ///< Поворот вокруг оси X
+  kRotateY,    ///< Поворот вокруг оси Y
+  kRotateZ     ///< Поворот вокруг оси Z
+};
+
+/**
+ * @class TransformKernel
+ * @brief Преобразование массива вершин матрицей 4x4.
+ */
+class TransformKernel {
+ public:
+  /**
+   * @brief Преобразует вершины лучшей доступной реализацией
+   *
+   * Массивы `source` и `destination` могут совпадать.
+   *
+   * @param matrix Матрица преобразования
+   * @param source Исходные вершины, 3 * count чисел
+   * @param destination Результат, 3 * count чисел
+   * @param count Число вершин
+   */
+  static void Transform(const Mat4& matrix, const float* source,
+                        float* destination, std::size_t count);
+
+  /**
+   * @brief Преобразует вершины заданной реализацией
+   *
+   * Если процессор не поддерживает `level`, используется лучшая доступная
+   * реализация уровнем ниже.
+   *
+   * @param matrix Матрица преобразования
+   * @param source Исходные вершины
+   * @param destination Результат
+   * @param count Число вершин
+   * @param level Набор инструкций
+   */
+  static void Transform(const Mat4& matrix, const float* source,
+                        float* destination, std::size_t count,
+                        SimdLevel level);
+
+  /**
+   * @brief Преобразует вершины ядром, специализированным под вид матрицы
+   *
+   * Ядро читает из `matrix` только элементы, которые может изменить
+   * преобразование вида `shape`; для `TransformShape::kGeneral` вызывается
+   * общая реализация. Результат совпадает с общей реализацией, за
+   * исключением знака нулевых координат.
+   *
+   * @param matrix Матрица преобразования вида `shape`
+   * @param source Исходные вершины
+   * @param destination Результат
+   * @param count Число вершин
+   * @param shape Вид матрицы
+   */
+  static void Transform(const Mat4& matrix, const float* source,
+                        float* destination, std::size_t count,
+                        TransformShape shape);
+
+  /**
+   * @brief Возвращает лучший набор инструкций, поддерживаемый процессором
+   * @return Набор инструкций
+   */
+  static SimdLevel DetectLevel();
+};
+
+}  // namespace s21
+
+#endif  // TRANSFORM_KERNEL_H
@@ -0,0 +1,148 @@
+/**
+ * @file bounded_queue.h
+ * @brief Заголовочный файл для ограниченной очереди между потоками.
+ *
+ * `BoundedQueue` передаёт элементы от производителя к потребителю. Если в
+ * очереди уже `Capacity()` элементов, `Push` ждёт, пока потребитель их
+ * заберёт, поэтому отставание потребителя ограничивает память, а не растит
+ * её. После `Close` новые элементы не принимаются, а `Pop` отдаёт
+ * оставшиеся и затем сообщает о конце очереди.
+ */
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace s21 {
+
+/**
+ * @class BoundedQueue
+ * @brief Очередь ограниченной ёмкости с блокирующими `Push` и `Pop`.
+ *
+ * @tparam T Тип элементов
+ */
+template <typename T>
+class BoundedQueue {
+ public:
+  /**
+   * @brief Создаёт пустую очередь
+   * @param capacity Наибольшее число элементов (не меньше 1)
+   */
+  explicit BoundedQueue(std::size_t capacity)
+      : capacity_(capacity ? capacity : 1) {}
+
+  BoundedQueue(const BoundedQueue &) = delete;
+  BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+  /**
+   * @brief Добавляет элемент, дожидаясь свободного места
+   * @param value Элемент
+   * @return false, если очередь закрыта и элемент не добавлен
+   */
+  bool Push(T value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock,
+                   [this] { return closed_ || items_.size() < capacity_; });
+    if (closed_) return false;
+    items_.push_back(std::move(value));
+    lock.unlock();
+    not_empty_.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Добавляет элемент, только если есть свободное место
+   *
+   * Не ждёт, поэтому подходит для потока интерфейса.
+   *
+   * @param value Элемент; перемещается в очередь только при успехе
+   * @return false, если очередь заполнена или закрыта
+   */
+  bool TryPush(T &value) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closed_ || items_.size() >= capacity_) return false;
+      items_.push_back(std::move(value));
+    }
+    not_empty_.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Забирает элемент, дожидаясь его появления
+   * @return Элемент или пустое значение, если очередь закрыта и пуста
+   */
+  std::optional<T> Pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+    if (items_.empty()) return std::nullopt;
+    std::optional<T> value(std::move(items_.front()));
+    items_.pop_front();
+    lock.unlock();
+    not_full_.notify_one();
+    return value;
+  }
+
+  /**
+   * @brief Закрывает очередь и будит ожидающие потоки
+   *
+   * Элементы, добавленные до закрытия, остаются доступны `Pop`.
+   */
+  void Close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+    }
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+  /**
+   * @brief Удаляет элементы, ещё не забранные потребителем
+   */
+  void Clear() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      items_.clear();
+    }
+    not_full_.notify_all();
+  }
+
+  /**
+   * @brief Проверяет, закрыта ли очередь
+   */
+  bool IsClosed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+  }
+
+  /**
+   * @brief Возвращает число элементов в очереди
+   */
+  std::size_t Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return items_.size();
+  }
+
+  /**
+   * @brief Возвращает ёмкость очереди
+   */
+  std::size_t Capacity() const { return capacity_; }
+
+ private:
+  const std::size_t capacity_;         ///< Наибольшее число элементов
+  mutable std::mutex mutex_;           ///< Защищает очередь и флаг
+  std::condition_variable not_full_;   ///< Появилось свободное место
+  std::condition_variable not_empty_;  ///< Появился элемент или закрытие
+  std::deque<T> items_;                ///< Элементы
+  bool closed_ = false;                ///< Очередь закрыта
+};
+
+}  // namespace s21
+
+#endif  // BOUNDED_QUEUE_H
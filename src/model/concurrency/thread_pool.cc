@@ -0,0 +1,125 @@
+/**
+ * @file thread_pool.cc
+ * @brief Реализация класса ThreadPool.
+ */
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace s21 {
+
+/**
+ * Пакет задач одного вызова `Run`. Номера задач раздаются через счётчик
+ * `next`, поэтому рабочий поток, взявший пакет из очереди после того, как все
+ * задачи уже разобраны, только проверяет счётчик и не обращается к `task`.
+ */
+struct ThreadPool::Batch {
+  const std::function<void(std::size_t)> *task;
+  std::size_t count;
+  std::atomic<std::size_t> next{0};
+  std::atomic<std::size_t> finished{0};
+  std::mutex mutex;
+  std::condition_variable done;
+  std::exception_ptr error;
+};
+
+ThreadPool::ThreadPool(unsigned int workers) {
+  workers_.reserve(workers);
+  for (unsigned int i = 0; i < workers; ++i) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto &worker : workers_) worker.join();
+}
+
+ThreadPool &ThreadPool::Instance() {
+  static ThreadPool pool{
+      std::max(std::thread::hardware_concurrency(), 1u) - 1};
+  return pool;
+}
+
+unsigned int ThreadPool::Size() const {
+  return static_cast<unsigned int>(workers_.size()) + 1;
+}
+
+void ThreadPool::Run(std::size_t count,
+                     const std::function<void(std::size_t)> &task) {
+  if (count == 0) return;
+  if (count == 1 || workers_.empty()) {
+    for (std::size_t i = 0; i < count; ++i) task(i);
+    return;
+  }
+  auto batch = std::make_shared<Batch>();
+  batch->task = &task;
+  batch->count = count;
+  std::size_t helpers = std::min(count - 1, workers_.size());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i = 0; i < helpers; ++i) queue_.push_back(batch);
+  }
+  if (helpers == 1) {
+    wake_.notify_one();
+  } else {
+    wake_.notify_all();
+  }
+
+  Drain(*batch);
+  std::unique_lock<std::mutex> lock(batch->mutex);
+  batch->done.wait(lock, [&] { return batch->finished == count; });
+  if (batch->error) std::rethrow_exception(batch->error);
+}
+
+void ThreadPool::ParallelFor(
+    std::size_t count, std::size_t min_per_task,
+    const std::function<void(std::size_t, std::size_t)> &body) {
+  std::size_t parts = std::min<std::size_t>(
+      Size(), count / std::max<std::size_t>(min_per_task, 1));
+  if (parts <= 1) {
+    if (count) body(0, count);
+    return;
+  }
+  Run(parts, [&](std::size_t i) {
+    body(count * i / parts, count * (i + 1) / parts);
+  });
+}
+
+void ThreadPool::Drain(Batch &batch) {
+  for (std::size_t i = batch.next++; i < batch.count; i = batch.next++) {
+    try {
+      (*batch.task)(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(batch.mutex);
+      if (!batch.error) batch.error = std::current_exception();
+    }
+    if (++batch.finished == batch.count) {
+      std::lock_guard<std::mutex> lock(batch.mutex);
+      batch.done.notify_all();
+    }
+  }
+}
+
+void ThreadPool::WorkerLoop() {
+  for (;;) {
+    std::shared_ptr<Batch> batch;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) return;
+      batch = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    Drain(*batch);
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,111 @@
+/**
+ * @file thread_pool.h
+ * @brief Заголовочный файл для пула рабочих потоков.
+ *
+ * `ThreadPool` создаёт рабочие потоки один раз и переиспользует их для всех
+ * параллельных операций модели: преобразования вершин, расчёта габаритов,
+ * разбора файла и построения рёбер. Поток, вызвавший `Run` или `ParallelFor`,
+ * сам выполняет часть задач и дожидается остальных, поэтому вложенные вызовы
+ * не приводят к взаимной блокировке, а пул без рабочих потоков выполняет всё
+ * последовательно.
+ */
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @class ThreadPool
+ * @brief Пул постоянных рабочих потоков.
+ */
+class ThreadPool {
+ public:
+  /**
+   * @brief Создаёт пул с заданным числом рабочих потоков
+   * @param workers Число рабочих потоков, не считая вызывающего
+   */
+  explicit ThreadPool(unsigned int workers);
+
+  /**
+   * @brief Останавливает и присоединяет рабочие потоки
+   */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * @brief Возвращает общий пул приложения
+   *
+   * Пул создаётся при первом обращении; вместе с вызывающим потоком он
+   * использует все аппаратные потоки.
+   *
+   * @return Общий пул
+   */
+  static ThreadPool &Instance();
+
+  /**
+   * @brief Возвращает число потоков, выполняющих задачи
+   * @return Число рабочих потоков плюс вызывающий поток
+   */
+  unsigned int Size() const;
+
+  /**
+   * @brief Выполняет задачи с номерами от 0 до count - 1 и ждёт их завершения
+   *
+   * Если задача выбросила исключение, оставшиеся задачи всё равно
+   * выполняются, после чего первое исключение пробрасывается вызывающему.
+   *
+   * @param count Число задач
+   * @param task Функция, принимающая номер задачи
+   */
+  void Run(std::size_t count, const std::function<void(std::size_t)> &task);
+
+  /**
+   * @brief Делит диапазон [0, count) на части и обрабатывает их параллельно
+   *
+   * Число частей не превышает `Size()`, и на каждую приходится не меньше
+   * `min_per_task` элементов. Если получается одна часть, `body` вызывается
+   * в текущем потоке без синхронизации.
+   *
+   * @param count Размер диапазона
+   * @param min_per_task Минимальное число элементов в части
+   * @param body Функция, принимающая границы части [begin, end)
+   */
+  void ParallelFor(
+      std::size_t count, std::size_t min_per_task,
+      const std::function<void(std::size_t, std::size_t)> &body);
+
+ private:
+  struct Batch;
+
+  /**
+   * @brief Выполняет задачи пакета, пока они не закончатся
+   * @param batch Пакет задач
+   */
+  static void Drain(Batch &batch);
+
+  /**
+   * @brief Цикл рабочего потока
+   */
+  void WorkerLoop();
+
+  std::vector<std::thread> workers_;           ///< Рабочие потоки
+  std::deque<std::shared_ptr<Batch>> queue_;   ///< Пакеты, ждущие помощи
+  std::mutex mutex_;                           ///< Защищает очередь
+  std::condition_variable wake_;               ///< Будит рабочие потоки
+  bool stop_{false};                           ///< Признак остановки
+};
+
+}  // namespace s21
+
+#endif  // THREAD_POOL_H
@@ -5,19 +5,23 @@
 #include "model.h"
 
 #include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <mutex>
+
+#include "concurrency/thread_pool.h"
+#include "parser/mesh_cache.h"
 
 using namespace s21;
 
-s21::Model::Model() : parser_(), affine_transform_() {}
+s21::Model::Model() : affine_transform_() {}
 
 s21::Model::~Model() {}
 
 std::pair<bool, std::string> s21::Model::LoadFile(const std::string &path) {
   try {
-    parser_.LoadFile(path);
-    object_data_ = parser_.GetData();
-    affine_transform_.AddVertices(&object_data_.vertices);
-    ResetTransform();
+    SetData(ReadFile(path, cache_enabled_));
     return {true, ""};
   } catch (const std::exception &e) {
     std::cerr << "Error while loading file: " << e.what() << std::endl;
@@ -25,63 +29,197 @@ std::pair<bool, std::string> s21::Model::LoadFile(const std::string &path) {
   }
 }
 
+ObjectData s21::Model::ReadFile(const std::string &path, bool use_cache,
+                                const ProgressCallback &progress,
+                                const std::atomic<bool> *cancel) {
+  auto start = std::chrono::steady_clock::now();
+  // Этапы после разбора не сообщают о ходе загрузки, поэтому флаг отмены
+  // проверяется между ними.
+  auto check_cancel = [cancel] {
+    if (cancel && cancel->load()) throw LoadCanceled{};
+  };
+  ObjectData data;
+  if (!use_cache || !MeshCache::Load(path, data) || data.vertices.empty()) {
+    check_cancel();
+    Parser parser;
+    parser.SetProgressCallback(progress);
+    parser.SetCancelFlag(cancel);
+    parser.LoadFile(path);
+    data = parser.TakeData();
+    check_cancel();
+    NormalizeVertices(data.vertices, data.stats.bbox.data());
+    check_cancel();
+    if (use_cache) MeshCache::Save(path, data);
+  }
+  check_cancel();
+  data.stats.memory_bytes =
+      data.vertices.size() * sizeof(float) + data.faces.Bytes();
+  data.stats.index_size = data.faces.ElementSize();
+  data.stats.saved_bytes =
+      data.faces.Size() * sizeof(unsigned int) - data.faces.Bytes();
+  data.stats.load_seconds = std::chrono::duration<double>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+  return data;
+}
+
+void s21::Model::SetData(ObjectData data) {
+  mesh_.vertices = SharedBuffer<std::vector<float>>(std::move(data.vertices));
+  mesh_.faces = SharedBuffer<IndexBuffer>(std::move(data.faces));
+  stats_ = data.stats;
+  spare_vertices_ = {};
+  affine_transform_.SetVertices(mesh_.vertices.Edit());
+  affine_transform_.Reset();
+  current_state_ = {{1, 1, 1}, {0, 0, 0}, {0, 0, 0}};
+}
+
+void s21::Model::SetCacheEnabled(bool enabled) { cache_enabled_ = enabled; }
+
+bool s21::Model::IsCacheEnabled() const { return cache_enabled_; }
+
 const std::vector<float> &s21::Model::GetVertices() const {
-  return object_data_.vertices;
+  return mesh_.vertices.Get();
+}
+
+const MeshBuffer &s21::Model::GetMesh() const { return mesh_; }
+
+const MeshStats &s21::Model::GetStats() const { return stats_; }
+
+std::vector<float> s21::Model::GetTransformedVertices() const {
+  return affine_transform_.GetTransformedVertices();
+}
+
+std::array<float, 16> s21::Model::GetModelMatrix() const {
+  return affine_transform_.GetModelMatrix();
 }
 
-const std::vector<unsigned int> &s21::Model::GetFaces() const {
-  return object_data_.faces;
+void s21::Model::SetTransformMode(TransformMode mode) {
+  if (mode == TransformMode::kBaked && !GetVertices().empty()) OwnVertices();
+  affine_transform_.SetMode(mode);
+}
+
+TransformMode s21::Model::GetTransformMode() const {
+  return affine_transform_.GetMode();
+}
+
+void s21::Model::BakeTransform() {
+  if (!GetVertices().empty()) OwnVertices();
+  affine_transform_.BakeVertices();
+}
+
+const IndexBuffer &s21::Model::GetFaces() const {
+  return mesh_.faces.Get();
 }
 
 void s21::Model::Transform(TransformParametrs &delta) {
-  affine_transform_.TransformVertices(delta);
+  if (affine_transform_.GetMode() == TransformMode::kRetained ||
+      mesh_.vertices.Edit()) {
+    affine_transform_.TransformVertices(delta);
+    return;
+  }
+  // Опубликованные вершины ещё читают: результат пишется во второй буфер.
+  affine_transform_.TransformVertices(delta, SpareVertices());
+  std::swap(mesh_.vertices, spare_vertices_);
 }
 
 void s21::Model::CalculateBoundingBox(float &min_x, float &min_y, float &min_z,
                                       float &max_x, float &max_y,
                                       float &max_z) {
-  if (object_data_.vertices.empty()) {
+  float bbox[6];
+  if (affine_transform_.GetMode() == TransformMode::kRetained &&
+      !GetVertices().empty()) {
+    BoundingBox(affine_transform_.GetTransformedVertices(), bbox);
+  } else {
+    BoundingBox(GetVertices(), bbox);
+  }
+  min_x = bbox[0];
+  min_y = bbox[1];
+  min_z = bbox[2];
+  max_x = bbox[3];
+  max_y = bbox[4];
+  max_z = bbox[5];
+}
+
+void s21::Model::ResetTransform() {
+  if (GetVertices().empty()) {
     throw std::invalid_argument("Vertices array is empty!");
   }
-  min_x = min_y = min_z = std::numeric_limits<float>::max();
-  max_x = max_y = max_z = std::numeric_limits<float>::lowest();
-
-  for (size_t i = 0; i < object_data_.vertices.size(); i += 3) {
-    float x = object_data_.vertices[i];
-    float y = object_data_.vertices[i + 1];
-    float z = object_data_.vertices[i + 2];
-    min_x = std::min(min_x, x);
-    min_y = std::min(min_y, y);
-    min_z = std::min(min_z, z);
-    max_x = std::max(max_x, x);
-    max_y = std::max(max_y, y);
-    max_z = std::max(max_z, z);
+  std::vector<float> *vertices = OwnVertices();
+  affine_transform_.BakeVertices();
+  float bbox[6];
+  BoundingBox(*vertices, bbox);
+  NormalizeVertices(*vertices, bbox);
+  affine_transform_.Reset();
+  current_state_ = {{1, 1, 1}, {0, 0, 0}, {0, 0, 0}};
+}
+
+std::vector<float> *s21::Model::OwnVertices() {
+  if (std::vector<float> *vertices = mesh_.vertices.Edit()) return vertices;
+  std::vector<float> *vertices = SpareVertices();
+  vertices->assign(GetVertices().begin(), GetVertices().end());
+  std::swap(mesh_.vertices, spare_vertices_);
+  affine_transform_.SetVertices(vertices);
+  return vertices;
+}
+
+std::vector<float> *s21::Model::SpareVertices() {
+  if (std::vector<float> *vertices = spare_vertices_.Edit()) return vertices;
+  spare_vertices_ = SharedBuffer<std::vector<float>>(std::vector<float>());
+  return spare_vertices_.Edit();
+}
+
+void s21::Model::BoundingBox(const std::vector<float> &vertices,
+                             float bbox[6]) {
+  if (vertices.empty()) {
+    throw std::invalid_argument("Vertices array is empty!");
   }
+  bbox[0] = bbox[1] = bbox[2] = std::numeric_limits<float>::max();
+  bbox[3] = bbox[4] = bbox[5] = std::numeric_limits<float>::lowest();
+
+  std::mutex merge;
+  ThreadPool::Instance().ParallelFor(
+      vertices.size() / 3, kMinVerticesPerTask, [&](size_t begin, size_t end) {
+        float part[6];
+        std::fill(part, part + 3, std::numeric_limits<float>::max());
+        std::fill(part + 3, part + 6, std::numeric_limits<float>::lowest());
+        for (size_t i = begin * 3; i < end * 3; i += 3) {
+          for (size_t axis = 0; axis < 3; ++axis) {
+            part[axis] = std::min(part[axis], vertices[i + axis]);
+            part[axis + 3] = std::max(part[axis + 3], vertices[i + axis]);
+          }
+        }
+        std::lock_guard<std::mutex> lock(merge);
+        for (size_t axis = 0; axis < 3; ++axis) {
+          bbox[axis] = std::min(bbox[axis], part[axis]);
+          bbox[axis + 3] = std::max(bbox[axis + 3], part[axis + 3]);
+        }
+      });
 }
 
-void s21::Model::ResetTransform() {
-  if (object_data_.vertices.empty()) {
+void s21::Model::NormalizeVertices(std::vector<float> &vertices,
+                                   const float bbox[6]) {
+  if (vertices.empty()) {
     throw std::invalid_argument("Vertices array is empty!");
   }
-  float min_x, min_y, min_z, max_x, max_y, max_z;
-  CalculateBoundingBox(min_x, min_y, min_z, max_x, max_y, max_z);
-  float center_x = min_x + (max_x - min_x) / 2.0f;
-  float center_y = min_y + (max_y - min_y) / 2.0f;
-  float center_z = min_z + (max_z - min_z) / 2.0f;
-
-  float size_x = max_x - min_x;
-  float size_y = max_y - min_y;
-  float size_z = max_z - min_z;
+  float center_x = bbox[0] + (bbox[3] - bbox[0]) / 2.0f;
+  float center_y = bbox[1] + (bbox[4] - bbox[1]) / 2.0f;
+  float center_z = bbox[2] + (bbox[5] - bbox[2]) / 2.0f;
+
+  float size_x = bbox[3] - bbox[0];
+  float size_y = bbox[4] - bbox[1];
+  float size_z = bbox[5] - bbox[2];
   float max_size = std::max({size_x, size_y, size_z});
   if (max_size == 0) max_size = 1.0f;
 
-  for (size_t i = 0; i < object_data_.vertices.size(); i += 3) {
-    object_data_.vertices[i] -= center_x;
-    object_data_.vertices[i + 1] -= center_y;
-    object_data_.vertices[i + 2] -= center_z;
-    object_data_.vertices[i] /= max_size;
-    object_data_.vertices[i + 1] /= max_size;
-    object_data_.vertices[i + 2] /= max_size;
-  }
-  current_state_ = {{1, 1, 1}, {0, 0, 0}, {0, 0, 0}};
+  ThreadPool::Instance().ParallelFor(
+      vertices.size() / 3, kMinVerticesPerTask, [&](size_t begin, size_t end) {
+        for (size_t i = begin * 3; i < end * 3; i += 3) {
+          vertices[i] -= center_x;
+          vertices[i + 1] -= center_y;
+          vertices[i + 2] -= center_z;
+          vertices[i] /= max_size;
+          vertices[i + 1] /= max_size;
+          vertices[i + 2] /= max_size;
+        }
+      });
 }
@@ -16,11 +16,26 @@
  * самого класса модели.
  * - **Фасад (Facade):** Метод LoadFile предоставляет упрощённый интерфейс для
  * загрузки модели, скрывая подробности работы с парсером и трансформациями.
+ *
+ * В режиме `TransformMode::kRetained` модель хранит исходные вершины и
+ * накопленную матрицу модели, которая применяется при отрисовке; вершины
+ * пересчитываются только по запросу (`GetTransformedVertices`,
+ * `BakeTransform`, вычисление ограничивающего прямоугольника).
+ *
+ * Загрузка разделена на чтение файла (`ReadFile`), которое не затрагивает
+ * текущую модель и может выполняться в другом потоке, и замену данных модели
+ * (`SetData`).
+ *
+ * Вершины и грани хранятся в разделяемых буферах (`MeshBuffer`), которые
+ * передаются в отрисовку без копирования. Опубликованные вершины не
+ * изменяются: пока их держит отрисовка, преобразование записывает результат
+ * во второй буфер вершин, и буферы меняются местами.
  */
 #ifndef MODEL_H_
 #define MODEL_H_
 
 #include "affine_transform/affinetransform.h"
+#include "parser/mesh_buffer.h"
 #include "parser/parser.h"
 
 namespace s21 {
@@ -29,9 +44,8 @@ class Model {
   /**
    * @brief Конструктор по умолчанию для класса Model.
    *
-   * Этот конструктор инициализирует объекты парсера (`parser_`) и
-   * трансформатора (`affine_transform_`), которые будут использоваться для
-   * загрузки данных модели и выполнения трансформаций.
+   * Этот конструктор инициализирует трансформатор (`affine_transform_`),
+   * который будет использоваться для выполнения трансформаций.
    *
    * Конструктор не принимает аргументов и не выполняет дополнительных операций,
    * кроме инициализации этих компонентов.
@@ -58,6 +72,55 @@ class Model {
    */
   std::pair<bool, std::string> LoadFile(const std::string &path);
 
+  /**
+   * @brief Чтение модели из файла без изменения текущей модели.
+   *
+   * Разбирает файл (или читает действительный кэш), нормализует вершины и при
+   * необходимости сохраняет кэш. В `ObjectData::stats` дополнительно
+   * записываются габариты модели, занимаемая память и время загрузки. Метод
+   * не обращается к состоянию объекта Model, поэтому может вызываться из
+   * рабочего потока.
+   *
+   * @param path Путь к файлу с моделью.
+   * @param use_cache true, чтобы использовать двоичный кэш.
+   * @param progress Получатель хода загрузки (может быть пустым).
+   * @param cancel Флаг отмены загрузки (может быть nullptr).
+   * @return Нормализованные данные модели.
+   * @throws LoadCanceled Если загрузка отменена.
+   * @throws std::exception Если файл не удаётся загрузить.
+   */
+  static ObjectData ReadFile(const std::string &path, bool use_cache,
+                             const ProgressCallback &progress = {},
+                             const std::atomic<bool> *cancel = nullptr);
+
+  /**
+   * @brief Замена данных модели.
+   *
+   * Устанавливает уже нормализованные данные, полученные из `ReadFile`, и
+   * сбрасывает состояние трансформаций.
+   *
+   * @param data Данные модели.
+   */
+  void SetData(ObjectData data);
+
+  /**
+   * @brief Включение двоичного кэша моделей.
+   *
+   * Если кэш включён, после успешного разбора рядом с файлом модели
+   * сохраняется двоичный кэш с нормализованными вершинами, а при последующих
+   * загрузках действительный кэш читается вместо разбора текста.
+   *
+   * @param enabled true, чтобы использовать кэш.
+   */
+  void SetCacheEnabled(bool enabled);
+
+  /**
+   * @brief Проверка, включён ли двоичный кэш моделей.
+   *
+   * @return true, если кэш включён.
+   */
+  bool IsCacheEnabled() const;
+
   /**
    * @brief Получение вершин модели.
    *
@@ -65,12 +128,73 @@ class Model {
    */
   const std::vector<float> &GetVertices() const;
 
+  /**
+   * @brief Получение разделяемых буферов модели.
+   *
+   * Копия результата разделяет данные с моделью. Версия вершин меняется
+   * после каждого преобразования в режиме `TransformMode::kBaked`, версия
+   * граней - только при загрузке новой модели.
+   *
+   * @return Ссылка на буферы вершин и граней.
+   */
+  const MeshBuffer &GetMesh() const;
+
+  /**
+   * @brief Получение сведений о модели.
+   *
+   * Сведения собираются один раз при загрузке и не зависят от трансформаций,
+   * поэтому их получение не требует обхода вершин.
+   *
+   * @return Число вершин, рёбер и граней, габариты в координатах файла,
+   * занимаемая память и время загрузки.
+   */
+  const MeshStats &GetStats() const;
+
+  /**
+   * @brief Получение вершин модели с применённой матрицей модели.
+   *
+   * В режиме `TransformMode::kBaked` совпадает с `GetVertices`.
+   *
+   * @return Копия преобразованных вершин.
+   */
+  std::vector<float> GetTransformedVertices() const;
+
+  /**
+   * @brief Получение накопленной матрицы модели.
+   *
+   * @return Матрица 4x4 в порядке по столбцам OpenGL.
+   */
+  std::array<float, 16> GetModelMatrix() const;
+
+  /**
+   * @brief Установка режима применения трансформаций.
+   *
+   * @param mode Режим трансформаций.
+   */
+  void SetTransformMode(TransformMode mode);
+
+  /**
+   * @brief Получение режима применения трансформаций.
+   *
+   * @return Режим трансформаций.
+   */
+  TransformMode GetTransformMode() const;
+
+  /**
+   * @brief Применение накопленной матрицы модели к вершинам.
+   *
+   * После вызова матрица модели единичная, а вершины содержат текущее
+   * положение модели.
+   */
+  void BakeTransform();
+
   /**
    * @brief Получение граней модели.
    *
-   * @return Ссылка на вектор с гранями модели.
+   * @return Ссылка на буфер пар индексов рёбер; разрядность индексов
+   * выбрана при загрузке.
    */
-  const std::vector<unsigned int> &GetFaces() const;
+  const IndexBuffer &GetFaces() const;
 
   /**
    * @brief Применение трансформаций к модели.
@@ -86,7 +210,7 @@ class Model {
    * @brief Вычисление ограничивающего прямоугольника для модели.
    *
    * Находит минимальные и максимальные координаты по осям X, Y и Z для всех
-   * вершин модели.
+   * вершин модели с учётом матрицы модели.
    *
    * @param min_x Минимальное значение X.
    * @param min_y Минимальное значение Y.
@@ -107,11 +231,60 @@ class Model {
   void ResetTransform();
 
  private:
-  ObjectData object_data_;  ///< Хранение данных объекта (вершины и грани).
-  s21::Parser parser_;      ///< Парсер для загрузки модели.
+  /**
+   * @brief Вычисление ограничивающего прямоугольника для вершин.
+   *
+   * Крупные модели обрабатываются частями в общем пуле потоков.
+   *
+   * @param vertices Вершины модели.
+   * @param bbox Результат {min_x, min_y, min_z, max_x, max_y, max_z}.
+   */
+  static void BoundingBox(const std::vector<float> &vertices, float bbox[6]);
+
+  /**
+   * @brief Центрирование вершин и приведение их к единичному размеру.
+   *
+   * Габариты передаются готовыми: при загрузке их собирает парсер, поэтому
+   * вершины обходятся один раз.
+   *
+   * @param vertices Вершины модели.
+   * @param bbox Габариты вершин {min_x, min_y, min_z, max_x, max_y, max_z}.
+   */
+  static void NormalizeVertices(std::vector<float> &vertices,
+                                const float bbox[6]);
+
+  /**
+   * @brief Получение вершин для изменения на месте.
+   *
+   * Если опубликованные вершины разделены с другими владельцами, они
+   * копируются во второй буфер, который становится текущим.
+   *
+   * @return Указатель на вершины модели.
+   */
+  std::vector<float> *OwnVertices();
+
+  /**
+   * @brief Получение второго буфера вершин для записи.
+   *
+   * Если второй буфер ещё держит отрисовка, вместо него создаётся новый.
+   *
+   * @return Указатель на вершины второго буфера.
+   */
+  std::vector<float> *SpareVertices();
+
+  /**
+   * Минимальное число вершин на поток при расчёте габаритов и нормализации.
+   */
+  static constexpr size_t kMinVerticesPerTask = 1 << 16;
+
+  MeshBuffer mesh_;                     ///< Вершины и грани модели.
+  SharedBuffer<std::vector<float>>
+      spare_vertices_;  ///< Второй буфер для преобразований.
+  MeshStats stats_;                     ///< Сведения о загруженной модели.
   s21::AffineTransform
       affine_transform_;              ///< Объект для выполнения трансформаций.
   TransformParametrs current_state_;  ///< Текущее состояние трансформаций.
+  bool cache_enabled_ = false;  ///< Использование двоичного кэша моделей.
 };
 }  // namespace s21
 
@@ -0,0 +1,73 @@
+/**
+ * @file model_loader.cc
+ * @brief Реализация методов класса ModelLoader.
+ */
+#include "model_loader.h"
+
+#include <algorithm>
+
+namespace s21 {
+
+ModelLoader::~ModelLoader() {
+  Cancel();
+  Wait();
+}
+
+void ModelLoader::Start(const std::string &path, bool use_cache,
+                        ProgressCallback progress, FinishedCallback finished) {
+  Cancel();
+  if (job_) retired_.push_back(std::move(job_));
+  JoinFinished();
+  job_ = std::make_unique<Job>();
+  Job *job = job_.get();
+  job->worker = std::thread([job, path, use_cache,
+                             progress = std::move(progress),
+                             finished = std::move(finished)] {
+    LoadResult result;
+    try {
+      result.data = Model::ReadFile(path, use_cache, progress, &job->cancel);
+      result.success = true;
+    } catch (const LoadCanceled &e) {
+      result.canceled = true;
+      result.error = e.what();
+    } catch (const std::exception &e) {
+      result.error = e.what();
+    }
+    // Загрузка, отменённая после разбора, тоже считается отменённой, а её
+    // данные освобождаются сразу.
+    if (job->cancel && result.success) {
+      result = {};
+      result.canceled = true;
+    }
+    job->loading = false;
+    if (finished) finished(std::move(result));
+  });
+}
+
+void ModelLoader::Cancel() {
+  if (job_) job_->cancel = true;
+}
+
+void ModelLoader::Wait() {
+  if (job_ && job_->worker.joinable()) job_->worker.join();
+  for (auto &job : retired_) {
+    if (job->worker.joinable()) job->worker.join();
+  }
+  retired_.clear();
+}
+
+bool ModelLoader::IsLoading() const { return job_ && job_->loading; }
+
+void ModelLoader::JoinFinished() {
+  auto first_running =
+      std::partition(retired_.begin(), retired_.end(),
+                     [](const std::unique_ptr<Job> &job) {
+                       return !job->loading;
+                     });
+  for (auto it = retired_.begin(); it != first_running; ++it) {
+    if ((*it)->worker.joinable()) (*it)->worker.join();
+  }
+  retired_.erase(retired_.begin(), first_running);
+}
+
+}  // namespace s21
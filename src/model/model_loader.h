@@ -0,0 +1,114 @@
+/**
+ * @file model_loader.h
+ * @brief Заголовочный файл для класса ModelLoader, загружающего модель в
+ * рабочем потоке.
+ *
+ * `ModelLoader` выполняет `Model::ReadFile` в отдельном потоке, передаёт ход
+ * загрузки и её результат через функции обратного вызова и позволяет отменить
+ * загрузку. Текущая модель при этом не изменяется: полученные данные
+ * передаются в `Model::SetData` вызывающей стороной, когда загрузка завершена.
+ */
+#ifndef MODEL_LOADER_H_
+#define MODEL_LOADER_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "model.h"
+
+namespace s21 {
+
+/**
+ * @brief Результат фоновой загрузки модели.
+ */
+struct LoadResult {
+  bool success = false;   ///< Модель загружена.
+  bool canceled = false;  ///< Загрузка отменена.
+  std::string error{};    ///< Сообщение об ошибке.
+  ObjectData data{};      ///< Нормализованные данные модели.
+};
+
+/**
+ * @class ModelLoader
+ * @brief Загрузка модели в рабочем потоке с отчётами о ходе и отменой.
+ */
+class ModelLoader {
+ public:
+  /**
+   * @brief Функция, получающая результат загрузки.
+   */
+  using FinishedCallback = std::function<void(LoadResult)>;
+
+  ModelLoader() = default;
+  ModelLoader(const ModelLoader &) = delete;
+  ModelLoader &operator=(const ModelLoader &) = delete;
+
+  /**
+   * @brief Деструктор отменяет текущую загрузку и дожидается её завершения.
+   */
+  ~ModelLoader();
+
+  /**
+   * @brief Начинает загрузку модели в рабочем потоке.
+   *
+   * Если предыдущая загрузка ещё идёт, она отменяется, но метод её не
+   * дожидается: поток отменённой загрузки присоединяется при следующем
+   * вызове `Start`, когда он уже завершён, или в `Wait`. Отменённая загрузка
+   * ещё может вызвать свои функции обратного вызова, поэтому вызывающая
+   * сторона отбрасывает устаревшие результаты. Обе функции обратного вызова
+   * вызываются из рабочего потока.
+   *
+   * @param path Путь к файлу с моделью.
+   * @param use_cache true, чтобы использовать двоичный кэш.
+   * @param progress Получатель хода загрузки (может быть пустым).
+   * @param finished Получатель результата загрузки.
+   */
+  void Start(const std::string &path, bool use_cache,
+             ProgressCallback progress, FinishedCallback finished);
+
+  /**
+   * @brief Запрашивает отмену текущей загрузки.
+   *
+   * Загрузка прерывается при ближайшей проверке флага отмены, а результат
+   * передаётся с признаком `canceled`.
+   */
+  void Cancel();
+
+  /**
+   * @brief Дожидается завершения текущей и отменённых загрузок.
+   */
+  void Wait();
+
+  /**
+   * @brief Проверяет, идёт ли загрузка.
+   *
+   * @return true, если рабочий поток ещё не передал результат.
+   */
+  bool IsLoading() const;
+
+ private:
+  /**
+   * @brief Загрузка в рабочем потоке.
+   */
+  struct Job {
+    std::thread worker;                ///< Рабочий поток загрузки.
+    std::atomic<bool> cancel{false};   ///< Флаг отмены загрузки.
+    std::atomic<bool> loading{true};   ///< Признак идущей загрузки.
+  };
+
+  /**
+   * @brief Присоединяет потоки отменённых загрузок, которые уже завершились.
+   */
+  void JoinFinished();
+
+  std::unique_ptr<Job> job_;                   ///< Текущая загрузка.
+  std::vector<std::unique_ptr<Job>> retired_;  ///< Отменённые загрузки.
+};
+
+}  // namespace s21
+
+#endif  // MODEL_LOADER_H_
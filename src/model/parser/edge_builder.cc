@@ -0,0 +1,72 @@
+/**
+ * @file edge_builder.cc
+ * @brief Реализация класса EdgeBuilder.
+ */
+
+#include "edge_builder.h"
+
+#include <algorithm>
+
+#include "../concurrency/thread_pool.h"
+#include "parser.h"
+
+namespace s21 {
+
+void EdgeBuilder::BuildUniqueEdges(std::vector<unsigned int>& edges,
+                                   unsigned int threads,
+                                   const std::atomic<bool>* cancel) {
+  std::vector<std::uint64_t> keys;
+  keys.reserve(edges.size() / 2);
+  for (std::size_t i = 0; i + 1 < edges.size(); i += 2) {
+    std::uint64_t a = edges[i], b = edges[i + 1];
+    if (a == b) continue;
+    keys.push_back(a < b ? (a << 32) | b : (b << 32) | a);
+  }
+  CheckCancel(cancel);
+  SortKeys(keys, threads ? threads : ThreadPool::Instance().Size(), cancel);
+  CheckCancel(cancel);
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  std::vector<unsigned int> unique_edges(keys.size() * 2);
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    unique_edges[2 * i] = static_cast<unsigned int>(keys[i] >> 32);
+    unique_edges[2 * i + 1] = static_cast<unsigned int>(keys[i]);
+  }
+  edges.swap(unique_edges);
+}
+
+void EdgeBuilder::SortKeys(std::vector<std::uint64_t>& keys,
+                           unsigned int threads,
+                           const std::atomic<bool>* cancel) {
+  std::size_t parts = std::min<std::size_t>(threads ? threads : 1,
+                                            keys.size() / kMinKeysPerThread);
+  if (parts <= 1) {
+    std::sort(keys.begin(), keys.end());
+    return;
+  }
+  std::vector<std::vector<std::uint64_t>::iterator> bounds(parts + 1);
+  for (std::size_t i = 0; i <= parts; ++i) {
+    bounds[i] = keys.begin() + keys.size() * i / parts;
+  }
+
+  ThreadPool& pool = ThreadPool::Instance();
+  pool.Run(parts, [&bounds, cancel](std::size_t i) {
+    // После отмены оставшиеся части не сортируются.
+    if (!cancel || !cancel->load()) std::sort(bounds[i], bounds[i + 1]);
+  });
+  for (std::size_t width = 1; width < parts; width *= 2) {
+    CheckCancel(cancel);
+    std::size_t pairs = (parts - width + 2 * width - 1) / (2 * width);
+    pool.Run(pairs, [&bounds, width, parts](std::size_t pair) {
+      std::size_t first = pair * 2 * width;
+      std::size_t last = std::min(first + 2 * width, parts);
+      std::inplace_merge(bounds[first], bounds[first + width], bounds[last]);
+    });
+  }
+}
+
+void EdgeBuilder::CheckCancel(const std::atomic<bool>* cancel) {
+  if (cancel && cancel->load()) throw LoadCanceled{};
+}
+
+}  // namespace s21
@@ -0,0 +1,75 @@
+/**
+ * @file edge_builder.h
+ * @brief Заголовочный файл для класса EdgeBuilder, строящего список
+ * уникальных рёбер модели.
+ *
+ * Парсер записывает каждую грань как замкнутую ломаную из пар индексов, поэтому
+ * в замкнутой сетке каждое внутреннее ребро встречается дважды (по разу в
+ * каждой из соседних граней). `EdgeBuilder` приводит пары к неориентированному
+ * виду, сортирует их и удаляет повторы и вырожденные рёбра.
+ */
+
+#ifndef EDGE_BUILDER_H_
+#define EDGE_BUILDER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @class EdgeBuilder
+ * @brief Построение уникальных неориентированных рёбер.
+ */
+class EdgeBuilder {
+ public:
+  /**
+   * @brief Оставляет в списке рёбер только уникальные рёбра
+   *
+   * Каждое ребро {a, b} приводится к виду {min(a, b), max(a, b)}. Рёбра с
+   * совпадающими концами отбрасываются. Результат упорядочен по первому, затем
+   * по второму индексу.
+   *
+   * @param edges Пары индексов вершин; заменяются уникальными рёбрами
+   * @param threads Число частей параллельной сортировки; 0 означает размер
+   * общего пула потоков
+   * @param cancel Флаг отмены, проверяемый между этапами сортировки и
+   * слияния (может быть nullptr)
+   * @throws LoadCanceled Если установлен флаг отмены
+   */
+  static void BuildUniqueEdges(std::vector<unsigned int>& edges,
+                               unsigned int threads = 0,
+                               const std::atomic<bool>* cancel = nullptr);
+
+ private:
+  /**
+   * Минимальное число рёбер на часть при параллельной сортировке
+   */
+  static constexpr std::size_t kMinKeysPerThread = 1 << 18;
+
+  /**
+   * @brief Сортирует ключи рёбер, при необходимости в нескольких потоках
+   *
+   * Части массива сортируются в общем пуле потоков, после чего попарно
+   * сливаются.
+   *
+   * @param keys Ключи рёбер
+   * @param threads Число частей
+   * @param cancel Флаг отмены (может быть nullptr)
+   * @throws LoadCanceled Если установлен флаг отмены
+   */
+  static void SortKeys(std::vector<std::uint64_t>& keys, unsigned int threads,
+                       const std::atomic<bool>* cancel);
+
+  /**
+   * @brief Выбрасывает `LoadCanceled`, если установлен флаг отмены
+   * @param cancel Флаг отмены (может быть nullptr)
+   */
+  static void CheckCancel(const std::atomic<bool>* cancel);
+};
+
+}  // namespace s21
+
+#endif  // EDGE_BUILDER_H_
@@ -0,0 +1,110 @@
+/**
+ * @file float_chars.h
+ * @brief Разбор чисел с плавающей точкой без зависимости от локали.
+ *
+ * `std::from_chars` для float и double есть в libstdc++ начиная с GCC 11, но
+ * отсутствует в libc++ старых версий Xcode. Если стандартная библиотека не
+ * объявляет `__cpp_lib_to_chars`, `FloatFromChars` разбирает число через
+ * `strtof_l`/`strtod_l` с локалью "C", принимая ту же запись, что и
+ * `std::from_chars` в формате `std::chars_format::general`.
+ */
+#ifndef FLOAT_CHARS_H
+#define FLOAT_CHARS_H
+
+#include <locale.h>
+#include <stdlib.h>
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
+
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace s21 {
+
+/**
+ * @brief Разбирает число вида [-]digits[.digits][(e|E)[+-]digits], а также
+ * [-]inf и [-]nan через `strtof_l`/`strtod_l` с локалью "C".
+ *
+ * Возвращает то же, что `std::from_chars`: указатель за концом числа и код
+ * ошибки. Шестнадцатеричная запись, ведущие пробелы и знак '+' не
+ * принимаются. При выходе за диапазон value не изменяется.
+ *
+ * @tparam Float float или double
+ */
+template <typename Float>
+std::from_chars_result LocaleFloatFromChars(const char* first,
+                                            const char* last, Float& value) {
+  auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+  const char* it = first;
+  if (it < last && *it == '-') ++it;
+  if (it < last && (is_digit(*it) || *it == '.')) {
+    // Десятичная запись выделяется здесь, чтобы strtod_l не принял
+    // шестнадцатеричную.
+    bool digits = false;
+    for (; it < last && is_digit(*it); ++it) digits = true;
+    if (it < last && *it == '.') {
+      for (++it; it < last && is_digit(*it); ++it) digits = true;
+    }
+    if (!digits) return {first, std::errc::invalid_argument};
+    if (it < last && (*it == 'e' || *it == 'E')) {
+      const char* exponent = it + 1;
+      if (exponent < last && (*exponent == '+' || *exponent == '-')) {
+        ++exponent;
+      }
+      if (exponent < last && is_digit(*exponent)) {
+        it = exponent;
+        while (it < last && is_digit(*it)) ++it;
+      }
+    }
+  } else {
+    // inf, infinity, nan или nan(...): конец определяет strtod_l.
+    auto is_word = [](char c) {
+      return std::isalnum(static_cast<unsigned char>(c)) || c == '_' ||
+             c == '(' || c == ')';
+    };
+    while (it < last && is_word(*it)) ++it;
+  }
+
+  // strtod_l ожидает строку с завершающим нулём.
+  static const locale_t c_locale = newlocale(LC_ALL_MASK, "C", locale_t(0));
+  const std::string token(first, it);
+  char* stop = nullptr;
+  errno = 0;
+  Float result;
+  if constexpr (std::is_same_v<Float, float>) {
+    result = strtof_l(token.c_str(), &stop, c_locale);
+  } else {
+    result = strtod_l(token.c_str(), &stop, c_locale);
+  }
+  if (stop == token.c_str()) return {first, std::errc::invalid_argument};
+  const char* end = first + (stop - token.c_str());
+  if (errno == ERANGE && (result == 0 || std::isinf(result))) {
+    return {end, std::errc::result_out_of_range};
+  }
+  value = result;
+  return {end, std::errc{}};
+}
+
+/**
+ * @brief `std::from_chars` для float и double, если стандартная библиотека
+ * его предоставляет, иначе `LocaleFloatFromChars`.
+ */
+template <typename Float>
+std::from_chars_result FloatFromChars(const char* first, const char* last,
+                                      Float& value) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  return std::from_chars(first, last, value);
+#else
+  return LocaleFloatFromChars(first, last, value);
+#endif
+}
+
+}  // namespace s21
+
+#endif  // FLOAT_CHARS_H
@@ -0,0 +1,72 @@
+/**
+ * @file index_buffer.cc
+ * @brief Реализация класса IndexBuffer.
+ */
+
+#include "index_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace s21 {
+
+IndexBuffer::IndexBuffer(std::vector<unsigned int> indices,
+                         std::size_t vertex_count)
+    : type_(TypeFor(vertex_count)) {
+  if (type_ == IndexType::kUint32) {
+    long_ = std::move(indices);
+    return;
+  }
+  short_.resize(indices.size());
+  std::transform(indices.begin(), indices.end(), short_.begin(),
+                 [](unsigned int index) {
+                   return static_cast<std::uint16_t>(index);
+                 });
+}
+
+IndexBuffer::IndexBuffer(IndexType type, const void *data, std::size_t count)
+    : type_(type) {
+  if (type_ == IndexType::kUint16) {
+    short_.resize(count);
+    if (count) std::memcpy(short_.data(), data, count * sizeof(std::uint16_t));
+  } else {
+    long_.resize(count);
+    if (count) std::memcpy(long_.data(), data, count * sizeof(unsigned int));
+  }
+}
+
+IndexType IndexBuffer::TypeFor(std::size_t vertex_count) {
+  return vertex_count <= kMaxShortVertices ? IndexType::kUint16
+                                           : IndexType::kUint32;
+}
+
+std::size_t IndexBuffer::Size() const {
+  return type_ == IndexType::kUint16 ? short_.size() : long_.size();
+}
+
+std::size_t IndexBuffer::ElementSize() const {
+  return type_ == IndexType::kUint16 ? sizeof(std::uint16_t)
+                                     : sizeof(unsigned int);
+}
+
+const void *IndexBuffer::Data() const {
+  if (type_ == IndexType::kUint16) return short_.data();
+  return long_.data();
+}
+
+bool IndexBuffer::operator==(const IndexBuffer &other) const {
+  return Visit([&other](const auto &lhs) {
+    return other.Visit([&lhs](const auto &rhs) {
+      return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    });
+  });
+}
+
+std::vector<unsigned int> IndexBuffer::ToVector() const {
+  return Visit([](const auto &indices) {
+    return std::vector<unsigned int>(indices.begin(), indices.end());
+  });
+}
+
+}  // namespace s21
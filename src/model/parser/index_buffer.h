@@ -0,0 +1,154 @@
+/**
+ * @file index_buffer.h
+ * @brief Заголовочный файл для буфера индексов рёбер модели.
+ *
+ * Буфер выбирает разрядность индексов при создании: если у модели не больше
+ * 65536 вершин, каждый индекс помещается в `std::uint16_t`, и буфер занимает
+ * вдвое меньше памяти, чем с индексами `unsigned int`. Такие модели
+ * составляют большинство, поэтому старшие нулевые байты индексов не хранятся
+ * и не передаются в OpenGL.
+ *
+ * Читать индексы можно по одному через `operator[]` или целым вектором
+ * нужного типа через `Visit`, который не проверяет разрядность на каждом
+ * элементе.
+ */
+
+#ifndef INDEX_BUFFER_H_
+#define INDEX_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * Разрядность индексов буфера
+ */
+enum class IndexType {
+  kUint16,  ///< Индексы `std::uint16_t`
+  kUint32   ///< Индексы `unsigned int`
+};
+
+/**
+ * @class IndexBuffer
+ * @brief Индексы рёбер в 16- или 32-битном представлении.
+ */
+class IndexBuffer {
+ public:
+  /// Наибольшее число вершин, индексы которых помещаются в 16 бит
+  static constexpr std::size_t kMaxShortVertices = 65536;
+
+  /**
+   * @brief Создаёт пустой буфер
+   */
+  IndexBuffer() = default;
+
+  /**
+   * @brief Создаёт буфер из 32-битных индексов
+   *
+   * Если индексы помещаются в 16 бит, они переписываются в 16-битный вектор,
+   * а исходный освобождается; иначе вектор забирается без копирования.
+   *
+   * @param indices Индексы вершин
+   * @param vertex_count Число вершин модели
+   */
+  IndexBuffer(std::vector<unsigned int> indices, std::size_t vertex_count);
+
+  /**
+   * @brief Копирует индексы заданной разрядности
+   *
+   * @param type Разрядность индексов в `data`
+   * @param data Индексы
+   * @param count Число индексов
+   */
+  IndexBuffer(IndexType type, const void *data, std::size_t count);
+
+  /**
+   * @brief Возвращает разрядность, подходящую для модели
+   *
+   * @param vertex_count Число вершин модели
+   * @return `kUint16`, если индексы помещаются в 16 бит, иначе `kUint32`
+   */
+  static IndexType TypeFor(std::size_t vertex_count);
+
+  /**
+   * @brief Возвращает разрядность индексов
+   * @return Разрядность индексов
+   */
+  IndexType Type() const { return type_; }
+
+  /**
+   * @brief Возвращает число индексов
+   * @return Число индексов
+   */
+  std::size_t Size() const;
+
+  /**
+   * @brief Проверяет, пуст ли буфер
+   * @return true, если индексов нет
+   */
+  bool Empty() const { return Size() == 0; }
+
+  /**
+   * @brief Возвращает размер одного индекса
+   * @return 2 или 4 байта
+   */
+  std::size_t ElementSize() const;
+
+  /**
+   * @brief Возвращает объём памяти под индексы
+   * @return Число байт
+   */
+  std::size_t Bytes() const { return Size() * ElementSize(); }
+
+  /**
+   * @brief Возвращает указатель на первый индекс
+   * @return Указатель на данные в представлении `Type()`
+   */
+  const void *Data() const;
+
+  /**
+   * @brief Возвращает индекс по номеру
+   * @param i Номер индекса
+   * @return Индекс вершины
+   */
+  unsigned int operator[](std::size_t i) const {
+    return type_ == IndexType::kUint16 ? short_[i] : long_[i];
+  }
+
+  /**
+   * @brief Сравнивает значения индексов независимо от разрядности
+   * @param other Другой буфер
+   * @return true, если последовательности индексов совпадают
+   */
+  bool operator==(const IndexBuffer &other) const;
+
+  /**
+   * @brief Возвращает копию индексов в 32-битном представлении
+   * @return Вектор индексов
+   */
+  std::vector<unsigned int> ToVector() const;
+
+  /**
+   * @brief Передаёт функции вектор индексов в его собственном типе
+   *
+   * @param function Функция, принимающая `const std::vector<std::uint16_t>&`
+   * и `const std::vector<unsigned int>&`
+   * @return Результат функции
+   */
+  template <typename Function>
+  decltype(auto) Visit(Function &&function) const {
+    if (type_ == IndexType::kUint16) return function(short_);
+    return function(long_);
+  }
+
+ private:
+  IndexType type_ = IndexType::kUint16;  ///< Разрядность индексов
+  std::vector<std::uint16_t> short_{};   ///< Индексы при `kUint16`
+  std::vector<unsigned int> long_{};     ///< Индексы при `kUint32`
+};
+
+}  // namespace s21
+
+#endif  // INDEX_BUFFER_H_
@@ -0,0 +1,82 @@
+/**
+ * @file mapped_file.h
+ * @brief Заголовочный файл для класса MappedFile, отображающего файл в память.
+ *
+ * Класс `MappedFile` открывает файл только для чтения и отображает его
+ * содержимое в адресное пространство процесса с помощью `mmap`. Парсер читает
+ * байты файла напрямую из отображения, без промежуточных потоков и строк.
+ */
+
+#ifndef MAPPED_FILE_H_
+#define MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+namespace s21 {
+
+/**
+ * @class MappedFile
+ * @brief RAII-обёртка над файлом, отображённым в память только для чтения.
+ *
+ * Отображение освобождается в деструкторе. Объект можно перемещать, но нельзя
+ * копировать.
+ */
+class MappedFile {
+ public:
+  /**
+   * @brief Открывает и отображает файл по указанному пути
+   *
+   * @param path Путь к файлу
+   * @throws std::logic_error Если файл не удаётся открыть или отобразить
+   */
+  explicit MappedFile(const std::string& path);
+
+  /**
+   * @brief Деструктор
+   *
+   * Снимает отображение файла.
+   */
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+   * @brief Конструктор перемещения
+   * @param other Объект для перемещения
+   */
+  MappedFile(MappedFile&& other) noexcept;
+
+  /**
+   * @brief Оператор присваивания перемещением
+   * @param other Объект для перемещения
+   * @return Ссылка на текущий объект
+   */
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  /**
+   * @brief Возвращает указатель на начало отображённых данных
+   * @return Указатель на первый байт файла (nullptr для пустого файла)
+   */
+  const char* Data() const;
+
+  /**
+   * @brief Возвращает размер отображённых данных
+   * @return Размер файла в байтах
+   */
+  std::size_t Size() const;
+
+ private:
+  /**
+   * @brief Снимает текущее отображение, если оно есть
+   */
+  void Release();
+
+  const char* data_ = nullptr;  ///< Начало отображения
+  std::size_t size_ = 0;        ///< Размер отображения в байтах
+};
+
+}  // namespace s21
+
+#endif  // MAPPED_FILE_H_
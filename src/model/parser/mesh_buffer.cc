@@ -0,0 +1,17 @@
+/**
+ * @file mesh_buffer.cc
+ * @brief Счётчик версий разделяемых буферов.
+ */
+
+#include "mesh_buffer.h"
+
+#include <atomic>
+
+namespace s21 {
+
+std::uint64_t NextBufferVersion() {
+  static std::atomic<std::uint64_t> counter{0};
+  return ++counter;
+}
+
+}  // namespace s21
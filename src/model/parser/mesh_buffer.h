@@ -0,0 +1,119 @@
+/**
+ * @file mesh_buffer.h
+ * @brief Заголовочный файл для разделяемых буферов данных модели.
+ *
+ * `SharedBuffer` владеет содержимым (вектором вершин или буфером индексов)
+ * через счётчик ссылок: копирование буфера копирует только указатель, поэтому
+ * модель и виджет отрисовки держат одни и те же вершины и грани. Каждое
+ * новое содержимое получает уникальный номер версии, по которому получатель
+ * узнаёт, изменился ли буфер.
+ *
+ * Содержимое, которое видит больше одного владельца, не изменяется. Изменить
+ * его на месте можно только через `Edit`, когда других владельцев нет;
+ * при этом буфер получает новую версию.
+ */
+
+#ifndef MESH_BUFFER_H_
+#define MESH_BUFFER_H_
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "index_buffer.h"
+
+namespace s21 {
+
+/**
+ * @brief Возвращает следующий номер версии буфера
+ *
+ * Номера уникальны в пределах процесса и никогда не равны нулю.
+ *
+ * @return Номер версии
+ */
+std::uint64_t NextBufferVersion();
+
+/**
+ * @class SharedBuffer
+ * @brief Содержимое с подсчётом ссылок и номером версии.
+ *
+ * Буфер не потокобезопасен: все его копии должны использоваться в одном
+ * потоке.
+ *
+ * @tparam T Тип содержимого, например `std::vector<float>`
+ */
+template <typename T>
+class SharedBuffer {
+ public:
+  /**
+   * @brief Создаёт пустой буфер с нулевой версией
+   */
+  SharedBuffer() = default;
+
+  /**
+   * @brief Забирает содержимое без копирования
+   * @param data Содержимое буфера
+   */
+  explicit SharedBuffer(T data)
+      : data_(std::make_shared<T>(std::move(data))),
+        version_(NextBufferVersion()) {}
+
+  /**
+   * @brief Возвращает содержимое буфера
+   * @return Ссылка на содержимое; для пустого буфера - на пустое значение
+   */
+  const T &Get() const { return data_ ? *data_ : Empty(); }
+
+  /**
+   * @brief Возвращает номер версии содержимого
+   * @return Номер версии; 0 для буфера, созданного по умолчанию
+   */
+  std::uint64_t Version() const { return version_; }
+
+  /**
+   * @brief Возвращает число владельцев содержимого
+   * @return Число копий буфера, разделяющих содержимое
+   */
+  long UseCount() const { return data_.use_count(); }
+
+  /**
+   * @brief Открывает содержимое для изменения на месте
+   *
+   * Доступ выдаётся, только если у содержимого нет других владельцев; буфер
+   * сразу получает новую версию.
+   *
+   * @return Указатель на содержимое или nullptr, если буфер пуст или разделён
+   */
+  T *Edit() {
+    if (!data_ || data_.use_count() > 1) return nullptr;
+    version_ = NextBufferVersion();
+    return data_.get();
+  }
+
+ private:
+  /**
+   * @brief Возвращает общее пустое значение
+   * @return Ссылка на значение, созданное по умолчанию
+   */
+  static const T &Empty() {
+    static const T empty;
+    return empty;
+  }
+
+  std::shared_ptr<T> data_{};  ///< Разделяемое содержимое
+  std::uint64_t version_ = 0;  ///< Версия содержимого
+};
+
+/**
+ * Разделяемые вершины и рёбра граней модели
+ */
+
+struct MeshBuffer {
+  SharedBuffer<std::vector<float>> vertices{};  ///< Координаты вершин x, y, z
+  SharedBuffer<IndexBuffer> faces{};           ///< Пары индексов вершин рёбер
+};
+
+}  // namespace s21
+
+#endif  // MESH_BUFFER_H_
@@ -0,0 +1,210 @@
+/**
+ * @file mesh_cache.cc
+ * @brief Реализация класса MeshCache.
+ */
+
+#include "mesh_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "mapped_file.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr char kMagic[8] = {'S', '2', '1', 'M', 'E', 'S', 'H', '\0'};
+constexpr std::uint32_t kVersion = 4;
+constexpr std::uint32_t kByteOrder = 0x01020304;
+constexpr std::size_t kHashBlockSize = 64 * 1024;
+
+/**
+ * Заголовок файла кэша. За ним следуют vertex_count чисел float и
+ * index_count индексов в разрядности `IndexBuffer::TypeFor` по числу вершин:
+ * std::uint16_t или unsigned int. Габариты bbox записаны в координатах
+ * исходного файла, до нормализации.
+ */
+struct CacheHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint64_t vertex_count;
+  std::uint64_t index_count;
+  float bbox[6];
+  std::uint64_t polygon_count;
+  std::uint64_t source_size;
+  std::int64_t source_mtime;
+  std::uint64_t source_hash;
+};
+
+static_assert(sizeof(CacheHeader) == 88, "Unexpected cache header layout");
+
+std::size_t IndexSize(const CacheHeader& header) {
+  return IndexBuffer::TypeFor(header.vertex_count / 3) == IndexType::kUint16
+             ? sizeof(std::uint16_t)
+             : sizeof(unsigned int);
+}
+
+/**
+ * @brief Проверяет согласованность счётчиков заголовка с размером файла
+ *
+ * Число координат должно быть кратно трём, число индексов — чётным, а размер
+ * данных — совпадать с размером файла. Произведения не вычисляются, поэтому
+ * повреждённые счётчики не приводят к переполнению.
+ */
+bool CountsMatchSize(const CacheHeader& header, std::size_t file_size) {
+  if (header.vertex_count % 3 != 0 || header.index_count % 2 != 0) {
+    return false;
+  }
+  std::uint64_t payload = file_size - sizeof(header);
+  if (header.vertex_count > payload / sizeof(float)) return false;
+  std::uint64_t index_bytes = payload - header.vertex_count * sizeof(float);
+  std::size_t index_size = IndexSize(header);
+  return index_bytes % index_size == 0 &&
+         index_bytes / index_size == header.index_count;
+}
+
+std::uint64_t Fnv1a(const char* data, std::size_t size, std::uint64_t hash) {
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+}  // namespace
+
+std::string MeshCache::CachePath(const std::string& source_path) {
+  return source_path + ".s21cache";
+}
+
+bool MeshCache::ReadSourceInfo(const std::string& source_path,
+                               SourceInfo& info) {
+  std::error_code error;
+  info.size = std::filesystem::file_size(source_path, error);
+  if (error) return false;
+  info.mtime = std::filesystem::last_write_time(source_path, error)
+                   .time_since_epoch()
+                   .count();
+  if (error) return false;
+
+  // Хэшируются только начало и конец файла, чтобы проверка кэша не требовала
+  // чтения всего исходного файла.
+  std::ifstream source(source_path, std::ios::binary);
+  if (!source.is_open()) return false;
+  std::vector<char> block(kHashBlockSize);
+  std::size_t head = std::min<std::uint64_t>(info.size, kHashBlockSize);
+  source.read(block.data(), head);
+  info.hash = Fnv1a(block.data(), head, 14695981039346656037ULL);
+  if (info.size > kHashBlockSize) {
+    std::size_t tail =
+        std::min<std::uint64_t>(info.size - head, kHashBlockSize);
+    source.seekg(info.size - tail);
+    source.read(block.data(), tail);
+    info.hash = Fnv1a(block.data(), tail, info.hash);
+  }
+  return static_cast<bool>(source);
+}
+
+bool MeshCache::Load(const std::string& source_path, ObjectData& data) {
+  SourceInfo info;
+  std::error_code error;
+  std::string cache_path = CachePath(source_path);
+  if (!std::filesystem::is_regular_file(cache_path, error) ||
+      !ReadSourceInfo(source_path, info)) {
+    return false;
+  }
+  try {
+    MappedFile cache{cache_path};
+    CacheHeader header;
+    if (cache.Size() < sizeof(header)) return false;
+    std::memcpy(&header, cache.Data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kVersion || header.byte_order != kByteOrder ||
+        header.source_size != info.size || header.source_mtime != info.mtime ||
+        header.source_hash != info.hash ||
+        !CountsMatchSize(header, cache.Size())) {
+      return false;
+    }
+    const float* vertices =
+        reinterpret_cast<const float*>(cache.Data() + sizeof(header));
+    data.vertices.assign(vertices, vertices + header.vertex_count);
+    data.faces = IndexBuffer(IndexBuffer::TypeFor(header.vertex_count / 3),
+                             vertices + header.vertex_count,
+                             header.index_count);
+    // Кэш заменяет валидацию парсера, поэтому индексы за пределами вершин
+    // означают повреждённый файл.
+    bool indices_valid = data.faces.Visit([&header](const auto& indices) {
+      return std::all_of(indices.begin(), indices.end(), [&](auto index) {
+        return index < header.vertex_count / 3;
+      });
+    });
+    if (!indices_valid) {
+      data = {};
+      return false;
+    }
+    data.stats = {};
+    data.stats.vertices = header.vertex_count / 3;
+    data.stats.edges = header.index_count / 2;
+    data.stats.polygons = header.polygon_count;
+    std::memcpy(data.stats.bbox.data(), header.bbox, sizeof(header.bbox));
+    data.stats.from_cache = true;
+    return true;
+  } catch (const std::exception&) {
+    return false;
+  }
+}
+
+bool MeshCache::Save(const std::string& source_path, const ObjectData& data) {
+  // Разрядность индексов в файле не записана и восстанавливается по числу
+  // вершин, поэтому буфер другой разрядности не сохраняется.
+  if (data.faces.Type() != IndexBuffer::TypeFor(data.vertices.size() / 3)) {
+    return false;
+  }
+  SourceInfo info;
+  if (!ReadSourceInfo(source_path, info)) return false;
+
+  CacheHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.byte_order = kByteOrder;
+  header.vertex_count = data.vertices.size();
+  header.index_count = data.faces.Size();
+  std::memcpy(header.bbox, data.stats.bbox.data(), sizeof(header.bbox));
+  header.polygon_count = data.stats.polygons;
+  header.source_size = info.size;
+  header.source_mtime = info.mtime;
+  header.source_hash = info.hash;
+
+  std::string cache_path = CachePath(source_path);
+  std::string temp_path = cache_path + ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(data.vertices.data()),
+              data.vertices.size() * sizeof(float));
+    out.write(reinterpret_cast<const char*>(data.faces.Data()),
+              data.faces.Bytes());
+    out.close();
+    if (!out) {
+      std::error_code ignored;
+      std::filesystem::remove(temp_path, ignored);
+      return false;
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temp_path, cache_path, error);
+  if (error) {
+    std::error_code ignored;
+    std::filesystem::remove(temp_path, ignored);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace s21
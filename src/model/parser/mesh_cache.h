@@ -0,0 +1,84 @@
+/**
+ * @file mesh_cache.h
+ * @brief Заголовочный файл для класса MeshCache, сохраняющего разобранную
+ * модель в компактный двоичный файл рядом с исходным.
+ *
+ * Файл кэша (`<путь к модели>.s21cache`) содержит заголовок, массив вершин,
+ * массив индексов рёбер, габариты модели в координатах исходного файла, число
+ * граней, а также размер, время изменения и хэш исходного файла. При
+ * повторной загрузке действительный кэш отображается в память и копируется в
+ * `ObjectData` без разбора текста, валидации и нормализации.
+ */
+
+#ifndef MESH_CACHE_H_
+#define MESH_CACHE_H_
+
+#include <cstdint>
+#include <string>
+
+#include "parser.h"
+
+namespace s21 {
+
+/**
+ * @class MeshCache
+ * @brief Чтение и запись двоичного кэша модели.
+ */
+class MeshCache {
+ public:
+  /**
+   * @brief Возвращает путь к файлу кэша для исходного файла
+   * @param source_path Путь к исходному OBJ-файлу
+   * @return Путь к файлу кэша
+   */
+  static std::string CachePath(const std::string& source_path);
+
+  /**
+   * @brief Загружает данные модели из кэша
+   *
+   * Кэш считается действительным, если совпадают его формат, размер, время
+   * изменения и хэш исходного файла, число координат кратно трём, число
+   * индексов чётно, размер данных соответствует счётчикам и все индексы
+   * меньше числа вершин. Кроме вершин и рёбер заполняются
+   * сведения `data.stats`, кроме времени загрузки и занимаемой памяти.
+   *
+   * @param source_path Путь к исходному OBJ-файлу
+   * @param data Данные объекта, заполняемые при успехе
+   * @return true, если данные загружены из кэша, false в противном случае
+   */
+  static bool Load(const std::string& source_path, ObjectData& data);
+
+  /**
+   * @brief Сохраняет данные модели в кэш
+   *
+   * Запись выполняется во временный файл, который затем атомарно
+   * переименовывается.
+   *
+   * @param source_path Путь к исходному OBJ-файлу
+   * @param data Данные объекта вместе со сведениями `data.stats`
+   * @return true, если кэш записан, false в противном случае
+   */
+  static bool Save(const std::string& source_path, const ObjectData& data);
+
+ private:
+  /**
+   * Сведения об исходном файле, по которым проверяется актуальность кэша
+   */
+  struct SourceInfo {
+    std::uint64_t size = 0;     ///< Размер файла в байтах
+    std::int64_t mtime = 0;     ///< Время последнего изменения
+    std::uint64_t hash = 0;     ///< Хэш начала и конца файла
+  };
+
+  /**
+   * @brief Собирает сведения об исходном файле
+   * @param source_path Путь к исходному файлу
+   * @param info Сведения, заполняемые при успехе
+   * @return true, если файл доступен для чтения
+   */
+  static bool ReadSourceInfo(const std::string& source_path, SourceInfo& info);
+};
+
+}  // namespace s21
+
+#endif  // MESH_CACHE_H_
@@ -6,96 +6,495 @@
 
 #include "parser.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <limits>
+
+#include "../concurrency/thread_pool.h"
+#include "edge_builder.h"
+#include "float_chars.h"
+
 namespace s21 {
 
+namespace {
+
+bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' ||
+         c == '\f';
+}
+
+bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+const char* SkipSpaces(const char* it, const char* end) {
+  while (it < end && IsSpace(*it)) ++it;
+  return it;
+}
+
+const char* SkipToken(const char* it, const char* end) {
+  while (it < end && !IsSpace(*it)) ++it;
+  return it;
+}
+
+// Знак '+' допустим в OBJ, но не принимается std::from_chars. Возвращает
+// начало числа без '+' или nullptr, если после знака нет цифры или точки
+// (так отсекаются "inf", "nan" и повторный знак).
+const char* SkipPlus(const char* it, const char* end) {
+  if (it < end && *it == '+') ++it;
+  const char* digits = it < end && *it == '-' ? it + 1 : it;
+  if (digits == end || (!IsDigit(*digits) && *digits != '.')) return nullptr;
+  return it;
+}
+
+// Разбирает число с плавающей точкой вида [+-]digits[.digits][(e|E)[+-]digits]
+// начиная с it. Результат округляется корректно и не зависит от локали. При
+// успехе сдвигает it за конец числа.
+bool ParseFloat(const char*& it, const char* end, float& value) {
+  const char* begin = SkipPlus(it, end);
+  if (!begin) return false;
+  auto [cursor, error] = FloatFromChars(begin, end, value);
+  if (cursor == begin) return false;
+  if (error == std::errc::result_out_of_range) {
+    // Значения вне диапазона float становятся бесконечностью или нулём.
+    double wide = 0;
+    if (FloatFromChars(begin, cursor, wide).ec == std::errc{}) {
+      value = static_cast<float>(wide);
+    } else {
+      const char* e = std::find_if(
+          begin, cursor, [](char c) { return c == 'e' || c == 'E'; });
+      bool tiny = e + 1 < cursor && e[1] == '-';
+      value = tiny ? 0.0f : std::numeric_limits<float>::infinity();
+      if (*begin == '-') value = -value;
+    }
+  }
+  it = cursor;
+  return true;
+}
+
+// Разбирает целое число вида [+-]digits, помещающееся в int.
+bool ParseInt(const char*& it, const char* end, long long& value) {
+  const char* begin = SkipPlus(it, end);
+  if (!begin) return false;
+  long long result = 0;
+  auto [cursor, error] = std::from_chars(begin, end, result);
+  if (error != std::errc{} || result > std::numeric_limits<int>::max() ||
+      result < -2147483648LL) {
+    return false;
+  }
+  value = result;
+  it = cursor;
+  return true;
+}
+
+}  // namespace
+
 void Parser::LoadFile(const std::string& path) {
-  std::vector<unsigned int> last_faces{std::move(data_.faces)};
+  IndexBuffer last_faces{std::move(data_.faces)};
   std::vector<float> last_vertices{std::move(data_.vertices)};
-  data_.faces.clear();
+  MeshStats last_stats = data_.stats;
+  data_.faces = {};
   data_.vertices.clear();
+  data_.stats = {};
+  edges_.clear();
+  extents_ = {};
+  ProgressState progress;
+  progress.callback = progress_callback_ ? &progress_callback_ : nullptr;
+  progress.cancel = cancel_;
   try {
-    ReadData(path);
+    if (load_mode_ == LoadMode::kMapped) {
+      ReadMappedData(path, progress);
+    } else {
+      ReadData(path, progress);
+    }
     ValidationData();
-  } catch (const std::exception& exception) {
+    if (cancel_ && cancel_->load()) throw LoadCanceled{};
+    EdgeBuilder::BuildUniqueEdges(edges_, thread_count_, cancel_);
+    data_.stats.vertices = data_.vertices.size() / 3;
+    data_.stats.edges = edges_.size() / 2;
+    data_.stats.polygons = progress.faces;
+    data_.stats.bbox = extents_.bbox;
+    data_.faces = IndexBuffer(std::move(edges_), data_.stats.vertices);
+    edges_ = {};
+    progress.bytes = progress.total;
+    ReportProgress(progress, 0, 0, 0);
+  } catch (const std::exception&) {
     data_.faces = std::move(last_faces);
     data_.vertices = std::move(last_vertices);
-    throw exception;
+    data_.stats = last_stats;
+    edges_ = {};
+    throw;
   }
 }
 
 const ObjectData& Parser::GetData() { return data_; }
 
-void Parser::ReadData(const std::string& path) {
+ObjectData Parser::TakeData() {
+  ObjectData data{std::move(data_)};
+  data_ = {};
+  return data;
+}
+
+void Parser::SetThreadCount(unsigned int count) { thread_count_ = count; }
+
+void Parser::SetLoadMode(LoadMode mode) { load_mode_ = mode; }
+
+LoadMode Parser::GetLoadMode() const { return load_mode_; }
+
+void Parser::SetProgressCallback(ProgressCallback callback) {
+  progress_callback_ = std::move(callback);
+}
+
+void Parser::SetCancelFlag(const std::atomic<bool>* cancel) {
+  cancel_ = cancel;
+}
+
+void Parser::ReadData(const std::string& path, ProgressState& progress) {
   std::ifstream source;
   source.open(path, std::ios::out);
   if (source.is_open()) {
-    ReserveSpace(source);
+    source.seekg(0, std::ios::end);
+    progress.total = static_cast<std::size_t>(source.tellg());
+    source.seekg(0);
+    // Выборка для оценки состава строк читается теми же участками, что и
+    // при отображении файла в память.
+    LineMix mix;
+    std::string window(kReserveSampleSize, '\0');
+    for (std::size_t i = 0; i < kReserveSamples; ++i) {
+      std::size_t offset = 0;
+      if (progress.total > kReserveSampleSize) {
+        offset = (progress.total - kReserveSampleSize) * i /
+                 (kReserveSamples - 1);
+      } else if (i) {
+        break;
+      }
+      source.seekg(offset);
+      source.read(window.data(), kReserveSampleSize);
+      const char* begin = window.data();
+      const char* end = begin + source.gcount();
+      source.clear();
+      if (offset) {
+        begin = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+        if (!begin) continue;
+        ++begin;
+      }
+      CountLineMix(begin, end, mix);
+    }
+    source.seekg(0);
+    ReserveSpace(progress.total, mix, data_.vertices, edges_);
 
     std::string line;
+    std::size_t bytes = 0, faces = 0;
+    std::size_t reported_bytes = 0, reported_vertices = 0, reported_faces = 0;
 
     while (std::getline(source >> std::ws, line)) {
+      bytes += line.size() + 1;
+      if (bytes - reported_bytes >= kProgressStep) {
+        std::size_t vertices = data_.vertices.size() / 3;
+        ReportProgress(progress, bytes - reported_bytes,
+                       vertices - reported_vertices, faces - reported_faces);
+        reported_bytes = bytes;
+        reported_vertices = vertices;
+        reported_faces = faces;
+      }
       if (line.empty() || line[0] == '#') continue;
       if (line.at(0) == 'v') ParseVertex(line);
-      if (line.at(0) == 'f') ParseFaces(line);
+      if (line.at(0) == 'f') {
+        ParseFaces(line);
+        ++faces;
+      }
     }
+    ReportProgress(progress, 0, data_.vertices.size() / 3 - reported_vertices,
+                   faces - reported_faces);
 
   } else {
     throw std::logic_error{"Can't open file"};
   }
 };
 
-void Parser::ReserveSpace(std::ifstream& in) {
-  unsigned int vertex_count = 0, face_count = 0;
-  std::string line;
-  while (std::getline(in >> std::ws, line)) {
-    if (line.empty() || line[0] == '#') continue;
-    if (line.at(0) == 'v') {
-      if (line.at(1) == ' ') vertex_count++;
-    } else if (line.at(0) == 'f') {
-      face_count++;
+void Parser::ReserveSpace(std::size_t bytes, const LineMix& mix,
+                          std::vector<float>& vertices,
+                          std::vector<unsigned int>& faces) {
+  if (mix.coordinates == 0 && mix.indices == 0) {
+    vertices.reserve(bytes / kBytesPerCoordinate);
+    faces.reserve(bytes / kBytesPerIndex);
+    return;
+  }
+  double scale = static_cast<double>(bytes) / mix.bytes * 1.125;
+  vertices.reserve(static_cast<std::size_t>(mix.coordinates * scale));
+  faces.reserve(static_cast<std::size_t>(mix.indices * scale));
+}
+
+void Parser::CountLineMix(const char* begin, const char* end, LineMix& mix) {
+  const char* it = begin;
+  while (it < end) {
+    const char* line_end =
+        static_cast<const char*>(std::memchr(it, '\n', end - it));
+    if (!line_end) break;
+    const char* token = SkipSpaces(it, line_end);
+    bool vertex = token + 1 < line_end && *token == 'v' && IsSpace(token[1]);
+    bool face = token + 1 < line_end && *token == 'f' && IsSpace(token[1]);
+    if (vertex || face) {
+      std::size_t values = 0;
+      for (token = SkipSpaces(token + 1, line_end); token < line_end;
+           token = SkipSpaces(SkipToken(token, line_end), line_end)) {
+        ++values;
+      }
+      // Грань из k вершин даёт k рёбер, то есть 2k индексов.
+      if (vertex) mix.coordinates += values;
+      if (face) mix.indices += values * 2;
+    }
+    mix.bytes += line_end + 1 - it;
+    it = line_end + 1;
+  }
+}
+
+Parser::LineMix Parser::SampleLineMix(const char* begin, const char* end) {
+  LineMix mix;
+  std::size_t size = end - begin;
+  if (size <= kReserveSampleSize * kReserveSamples) {
+    CountLineMix(begin, end, mix);
+    return mix;
+  }
+  for (std::size_t i = 0; i < kReserveSamples; ++i) {
+    const char* window =
+        begin + (size - kReserveSampleSize) * i / (kReserveSamples - 1);
+    const char* window_end = window + kReserveSampleSize;
+    if (window != begin) {
+      window = static_cast<const char*>(
+          std::memchr(window, '\n', window_end - window));
+      if (!window) continue;
+      ++window;
+    }
+    CountLineMix(window, window_end, mix);
+  }
+  return mix;
+}
+
+void Parser::ReadMappedData(const std::string& path,
+                            ProgressState& progress) {
+  MappedFile file{path};
+  progress.total = file.Size();
+  std::vector<Chunk> chunks =
+      SplitChunks(file.Data(), file.Data() + file.Size(), ChunkCount(file));
+  for (Chunk& chunk : chunks) chunk.progress = &progress;
+
+  ThreadPool::Instance().Run(
+      chunks.size(), [&chunks](std::size_t i) { ParseChunk(chunks[i]); });
+  MergeChunks(chunks);
+}
+
+unsigned int Parser::ChunkCount(const MappedFile& file) const {
+  unsigned int threads =
+      thread_count_ ? thread_count_ : ThreadPool::Instance().Size();
+  std::size_t by_size = file.Size() / kMinChunkSize;
+  if (by_size < threads) threads = static_cast<unsigned int>(by_size);
+  return threads ? threads : 1;
+}
+
+std::vector<Parser::Chunk> Parser::SplitChunks(const char* begin,
+                                               const char* end,
+                                               unsigned int count) {
+  std::vector<Chunk> chunks(count);
+  std::size_t size = end - begin;
+  const char* chunk_begin = begin;
+  for (unsigned int i = 0; i < count; ++i) {
+    const char* chunk_end = end;
+    if (i + 1 < count) {
+      chunk_end = begin + size / count * (i + 1);
+      if (chunk_end < chunk_begin) chunk_end = chunk_begin;
+      chunk_end = static_cast<const char*>(
+          std::memchr(chunk_end, '\n', end - chunk_end));
+      chunk_end = chunk_end ? chunk_end + 1 : end;
+    }
+    chunks[i].begin = chunk_begin;
+    chunks[i].end = chunk_end;
+    chunk_begin = chunk_end;
+  }
+  return chunks;
+}
+
+void Parser::ParseChunk(Chunk& chunk) {
+  ReserveSpace(chunk.end - chunk.begin, SampleLineMix(chunk.begin, chunk.end),
+               chunk.vertices, chunk.faces);
+  const char* it = chunk.begin;
+  const char* end = chunk.end;
+  const char* reported = chunk.begin;
+  std::size_t faces = 0, reported_vertices = 0, reported_faces = 0;
+  auto report = [&]() {
+    if (!chunk.progress) return;
+    std::size_t vertices = chunk.vertices.size() / 3;
+    ReportProgress(*chunk.progress, it - reported, vertices - reported_vertices,
+                   faces - reported_faces);
+    reported = it;
+    reported_vertices = vertices;
+    reported_faces = faces;
+  };
+  while ((it = SkipSpaces(it, end)) < end) {
+    const char* line_end =
+        static_cast<const char*>(std::memchr(it, '\n', end - it));
+    if (!line_end) line_end = end;
+    if (*it == 'v') ParseVertex(it + 1, line_end, chunk);
+    if (*it == 'f') {
+      ParseFaces(it + 1, line_end, chunk);
+      ++faces;
+    }
+    it = line_end;
+    if (static_cast<std::size_t>(it - reported) >= kProgressStep) report();
+  }
+  it = end;
+  report();
+}
+
+void Parser::MergeChunks(std::vector<Chunk>& chunks) {
+  std::size_t vertices_size = 0, faces_size = 0;
+  for (Chunk& chunk : chunks) {
+    // Относительные индексы были разрешены по числу вершин внутри фрагмента,
+    // поэтому к ним прибавляется число вершин всех предыдущих фрагментов.
+    unsigned int offset = static_cast<unsigned int>(vertices_size / 3);
+    for (std::size_t position : chunk.relative_faces) {
+      chunk.faces[position] += offset;
+    }
+    const Extents& part = chunk.extents;
+    extents_.min_index = std::min(
+        {extents_.min_index, part.min_index, part.min_relative + offset});
+    extents_.max_index = std::max(extents_.max_index, part.max_index);
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      AddCoordinate(extents_, axis, part.bbox[axis]);
+      AddCoordinate(extents_, axis, part.bbox[axis + 3]);
     }
+    vertices_size += chunk.vertices.size();
+    faces_size += chunk.faces.size();
+  }
+  data_.vertices = std::move(chunks.front().vertices);
+  edges_ = std::move(chunks.front().faces);
+  data_.vertices.reserve(vertices_size);
+  edges_.reserve(faces_size);
+  for (std::size_t i = 1; i < chunks.size(); ++i) {
+    data_.vertices.insert(data_.vertices.end(), chunks[i].vertices.begin(),
+                          chunks[i].vertices.end());
+    edges_.insert(edges_.end(), chunks[i].faces.begin(),
+                  chunks[i].faces.end());
+    std::vector<float>().swap(chunks[i].vertices);
+    std::vector<unsigned int>().swap(chunks[i].faces);
   }
-  data_.faces.reserve(face_count * 6);
-  data_.vertices.reserve(vertex_count * 3);
-  in.clear();
-  in.seekg(0);
+}
+
+void Parser::ReportProgress(ProgressState& progress, std::size_t bytes,
+                            std::size_t vertices, std::size_t faces) {
+  progress.bytes += bytes;
+  progress.vertices += vertices;
+  progress.faces += faces;
+  if (progress.cancel && progress.cancel->load()) throw LoadCanceled{};
+  if (!progress.callback) return;
+  // Если отчёт уже отправляет другой поток, этот отчёт пропускается: его
+  // данные войдут в следующий.
+  std::unique_lock<std::mutex> lock{progress.report_mutex, std::try_to_lock};
+  if (!lock.owns_lock()) return;
+  LoadProgress snapshot;
+  snapshot.bytes_parsed = std::min(progress.bytes.load(), progress.total);
+  snapshot.bytes_total = progress.total;
+  snapshot.vertices = progress.vertices;
+  snapshot.faces = progress.faces;
+  (*progress.callback)(snapshot);
 }
 
 void Parser::ParseVertex(const std::string& line) {
-  std::istringstream stream{line};
-  char type;
-  stream >> type;
+  const char* end = line.data() + line.size();
+  const char* it = SkipSpaces(line.data() + 1, end);
   float vertex{};
-  while (stream >> vertex) {
+  std::size_t axis = data_.vertices.size() % 3;
+  while (ParseFloat(it, end, vertex)) {
     data_.vertices.push_back(vertex);
+    AddCoordinate(extents_, axis, vertex);
+    axis = axis == 2 ? 0 : axis + 1;
+    it = SkipSpaces(it, end);
   }
 }
 
 void Parser::ParseFaces(const std::string& line) {
-  std::istringstream stream{line};
-  char type;
-  stream >> type;
-  int first_face{}, face{};
-  stream >> first_face;
-  if (first_face < 0)
-    first_face = (data_.vertices.size() / 3) + (first_face) + 1;
-  data_.faces.push_back(first_face - 1);
-  stream.ignore(256, ' ');
-  while (stream >> face) {
-    if (face < 0) face = (data_.vertices.size() / 3) + face + 1;
-    data_.faces.push_back(face - 1);
-    data_.faces.push_back(face - 1);
-    stream.ignore(256, ' ');
-  }
-  data_.faces.push_back(first_face - 1);
+  // Отрицательный индекс разрешается относительно уже прочитанных вершин.
+  long long vertex_count = static_cast<long long>(data_.vertices.size() / 3);
+  auto push_face = [this, vertex_count](long long face, int times) {
+    if (face < 0) face += vertex_count + 1;
+    for (int i = 0; i < times; ++i) {
+      edges_.push_back(static_cast<unsigned int>(face - 1));
+    }
+    AddIndex(extents_, face - 1);
+  };
+  const char* end = line.data() + line.size();
+  long long first_face{}, face{};
+  const char* it = SkipSpaces(line.data() + 1, end);
+  bool has_first = ParseInt(it, end, first_face);
+  push_face(first_face, 1);
+  if (has_first) {
+    it = SkipSpaces(SkipToken(it, end), end);
+    while (ParseInt(it, end, face)) {
+      push_face(face, 2);
+      it = SkipSpaces(SkipToken(it, end), end);
+    }
+  }
+  push_face(first_face, 1);
 }
 
-void Parser::ValidationData() {
-  size_t size_vertex = data_.vertices.size() / 3;
-  for (unsigned int i : data_.faces) {
-    if (i >= size_vertex) {
-      throw std::logic_error("Index more then vertices size");
+void Parser::ParseVertex(const char* begin, const char* end, Chunk& chunk) {
+  float vertex{};
+  std::size_t axis = chunk.vertices.size() % 3;
+  const char* it = SkipSpaces(begin, end);
+  while (ParseFloat(it, end, vertex)) {
+    chunk.vertices.push_back(vertex);
+    AddCoordinate(chunk.extents, axis, vertex);
+    axis = axis == 2 ? 0 : axis + 1;
+    it = SkipSpaces(it, end);
+  }
+}
+
+void Parser::ParseFaces(const char* begin, const char* end, Chunk& chunk) {
+  // Отрицательный индекс разрешается относительно вершин, уже прочитанных в
+  // этом фрагменте; его позиция запоминается для поправки в MergeChunks.
+  auto push_face = [&chunk](long long face, int times) {
+    if (face < 0) {
+      face += static_cast<long long>(chunk.vertices.size() / 3) + 1;
+      for (int i = 0; i < times; ++i) {
+        chunk.relative_faces.push_back(chunk.faces.size() + i);
+      }
+      chunk.extents.min_relative =
+          std::min(chunk.extents.min_relative, face - 1);
+    } else {
+      AddIndex(chunk.extents, face - 1);
+    }
+    for (int i = 0; i < times; ++i) {
+      chunk.faces.push_back(static_cast<unsigned int>(face - 1));
     }
+  };
+  long long first_face{}, face{};
+  const char* it = SkipSpaces(begin, end);
+  bool has_first = ParseInt(it, end, first_face);
+  push_face(first_face, 1);
+  if (has_first) {
+    it = SkipSpaces(SkipToken(it, end), end);
+    while (ParseInt(it, end, face)) {
+      push_face(face, 2);
+      it = SkipSpaces(SkipToken(it, end), end);
+    }
+  }
+  push_face(first_face, 1);
+}
+
+void Parser::AddCoordinate(Extents& extents, std::size_t axis, float value) {
+  extents.bbox[axis] = std::min(extents.bbox[axis], value);
+  extents.bbox[axis + 3] = std::max(extents.bbox[axis + 3], value);
+}
+
+void Parser::AddIndex(Extents& extents, long long index) {
+  extents.min_index = std::min(extents.min_index, index);
+  extents.max_index = std::max(extents.max_index, index);
+}
+
+void Parser::ValidationData() {
+  long long size_vertex = static_cast<long long>(data_.vertices.size() / 3);
+  if (extents_.min_index < 0 || extents_.max_index >= size_vertex) {
+    throw std::logic_error("Index more then vertices size");
   }
 }
 
@@ -10,9 +10,31 @@
  * - Загрузка данных из файла.
  * - Парсинг данных (вершин и граней).
  * - Валидация данных для проверки корректности.
+ * - Построение списка уникальных рёбер (`EdgeBuilder`).
  *
- * Данные объекта хранятся в структуре `ObjectData`, которая содержит два
- * вектора: `faces` для граней и `vertices` для вершин.
+ * Данные объекта хранятся в структуре `ObjectData`, которая содержит буфер
+ * `faces` уникальных рёбер граней (пары индексов вершин), вектор `vertices`
+ * вершин и сведения о модели (`MeshStats`): число вершин, рёбер и граней
+ * файла. Рёбра собираются в 32-битных индексах, а после загрузки переходят в
+ * `IndexBuffer`, который хранит их в 16 битах, если вершин не больше 65536.
+ *
+ * Парсер поддерживает два режима чтения (`LoadMode`): потоковый, с чтением
+ * строк через `std::ifstream`, и режим отображения файла в память, в котором
+ * строки разбираются прямо по байтам отображения без создания промежуточных
+ * строк.
+ *
+ * В обоих режимах числа разбираются через `std::from_chars`: результат
+ * округляется корректно и не зависит от текущей локали, поэтому десятичной
+ * точкой всегда служит '.'. Индексы граней читаются до первого '/', так что
+ * поддерживаются записи `v`, `v/vt`, `v//vn`, `v/vt/vn` и отрицательные
+ * индексы.
+ *
+ * В режиме отображения файл делится на фрагменты по границам строк, которые
+ * разбираются параллельно, после чего результаты склеиваются в порядке
+ * следования в файле.
+ *
+ * Во время разбора парсер может сообщать о ходе загрузки (`LoadProgress`) и
+ * прерывать её по флагу отмены, выбрасывая `LoadCanceled`.
  *
  * Этот файл предоставляет интерфейс для загрузки, чтения и получения данных
  * объекта, а также для их валидации.
@@ -20,19 +42,80 @@
 
 #ifndef __PARSER__H__
 #define __PARSER__H__
+#include <array>
+#include <atomic>
 #include <fstream>
-#include <sstream>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <vector>
+
+#include "index_buffer.h"
+#include "mapped_file.h"
 namespace s21 {
 
+/**
+ * Сведения о загруженной модели, собираемые один раз при загрузке
+ */
+
+struct MeshStats {
+  std::size_t vertices = 0;      ///< Число вершин
+  std::size_t edges = 0;         ///< Число уникальных рёбер
+  std::size_t polygons = 0;      ///< Число граней (строк `f`) в файле
+  std::array<float, 6> bbox{};   ///< Габариты в координатах файла
+                                 ///< {min_x, min_y, min_z, max_x, max_y, max_z}
+  std::size_t memory_bytes = 0;  ///< Память под вершины и рёбра
+  std::size_t index_size = 4;    ///< Размер индекса рёбер: 2 или 4 байта
+  std::size_t saved_bytes = 0;   ///< Экономия памяти на 16-битных индексах
+  double load_seconds = 0;       ///< Время загрузки
+  bool from_cache = false;       ///< Модель прочитана из двоичного кэша
+};
+
 /**
  * Структура, содержащая данные объектного файла
  */
 
 struct ObjectData {
-  std::vector<unsigned int> faces{};
+  IndexBuffer faces{};
   std::vector<float> vertices{};
+  MeshStats stats{};
+};
+
+/**
+ * Ход загрузки файла
+ */
+
+struct LoadProgress {
+  std::size_t bytes_parsed = 0;  ///< Разобрано байтов файла
+  std::size_t bytes_total = 0;   ///< Размер файла в байтах
+  std::size_t vertices = 0;      ///< Прочитано вершин
+  std::size_t faces = 0;         ///< Прочитано граней
+};
+
+/**
+ * Функция, получающая сведения о ходе загрузки
+ */
+
+using ProgressCallback = std::function<void(const LoadProgress&)>;
+
+/**
+ * Исключение, выбрасываемое при отмене загрузки
+ */
+
+class LoadCanceled : public std::runtime_error {
+ public:
+  LoadCanceled() : std::runtime_error("Loading canceled") {}
+};
+
+/**
+ * Режим чтения файла парсером
+ */
+
+enum class LoadMode {
+  kStream,  ///< Построчное чтение через std::ifstream
+  kMapped   ///< Разбор байтов файла, отображённого в память
 };
 
 /**
@@ -41,7 +124,93 @@ struct ObjectData {
 
 class Parser {
  private:
-  ObjectData data_{};  ///< Данные объекта
+  /**
+   * Минимальный размер фрагмента файла, разбираемого отдельным потоком
+   */
+  static constexpr std::size_t kMinChunkSize = 1 << 20;
+
+  /**
+   * Объём разобранных байтов, после которого сообщается ход загрузки и
+   * проверяется флаг отмены
+   */
+  static constexpr std::size_t kProgressStep = 1 << 18;
+
+  /**
+   * Размер и число участков данных, по строкам которых оценивается доля
+   * вершин и граней. Участки распределены по данным от начала до конца,
+   * поскольку в OBJ вершины обычно идут перед гранями.
+   */
+  static constexpr std::size_t kReserveSampleSize = 2048;
+  static constexpr std::size_t kReserveSamples = 8;
+
+  /**
+   * Оценка числа байтов файла на одну координату вершины и на один индекс
+   * рёбер для данных, в выборке которых нет ни вершин, ни граней
+   */
+  static constexpr std::size_t kBytesPerCoordinate = 24;
+  static constexpr std::size_t kBytesPerIndex = 6;
+
+  /**
+   * Состав строк выборки: по нему резервируется память вместо подсчёта строк
+   * всего файла
+   */
+  struct LineMix {
+    std::size_t bytes = 0;        ///< Размер разобранных строк
+    std::size_t coordinates = 0;  ///< Число координат в строках `v`
+    std::size_t indices = 0;      ///< Число индексов рёбер из строк `f`
+  };
+
+  /**
+   * Габариты вершин и диапазон индексов граней, собираемые во время разбора,
+   * чтобы валидация и нормализация не обходили данные повторно
+   */
+  struct Extents {
+    std::array<float, 6> bbox{std::numeric_limits<float>::max(),
+                              std::numeric_limits<float>::max(),
+                              std::numeric_limits<float>::max(),
+                              std::numeric_limits<float>::lowest(),
+                              std::numeric_limits<float>::lowest(),
+                              std::numeric_limits<float>::lowest()};
+    long long min_index = 0;     ///< Наименьший индекс вершины (с нуля)
+    long long max_index = -1;    ///< Наибольший индекс вершины (с нуля)
+    long long min_relative = 0;  ///< Наименьший относительный индекс,
+                                 ///< разрешённый внутри фрагмента
+  };
+
+  /**
+   * Общее для всех потоков разбора состояние хода загрузки
+   */
+  struct ProgressState {
+    std::atomic<std::size_t> bytes{0};     ///< Разобрано байтов
+    std::atomic<std::size_t> vertices{0};  ///< Прочитано вершин
+    std::atomic<std::size_t> faces{0};     ///< Прочитано граней
+    std::size_t total = 0;                 ///< Размер файла
+    const ProgressCallback* callback = nullptr;  ///< Получатель хода загрузки
+    const std::atomic<bool>* cancel = nullptr;   ///< Флаг отмены
+    std::mutex report_mutex{};  ///< Исключает одновременный вызов callback
+  };
+
+  /**
+   * Фрагмент отображённого файла и результат его разбора
+   */
+  struct Chunk {
+    const char* begin = nullptr;         ///< Начало фрагмента
+    const char* end = nullptr;           ///< Конец фрагмента
+    std::vector<float> vertices{};       ///< Вершины фрагмента
+    std::vector<unsigned int> faces{};   ///< Рёбра фрагмента
+    std::vector<std::size_t> relative_faces{};  ///< Позиции индексов,
+                                                ///< заданных относительно
+    Extents extents{};                  ///< Габариты и индексы фрагмента
+    ProgressState* progress = nullptr;  ///< Ход загрузки всего файла
+  };
+
+  ObjectData data_{};                     ///< Данные объекта
+  std::vector<unsigned int> edges_{};     ///< Рёбра до выбора разрядности
+  Extents extents_{};                     ///< Габариты и индексы файла
+  LoadMode load_mode_{LoadMode::kMapped};  ///< Режим чтения файла
+  unsigned int thread_count_{0};  ///< Число частей разбора (0 - размер пула)
+  ProgressCallback progress_callback_{};  ///< Получатель хода загрузки
+  const std::atomic<bool>* cancel_{nullptr};  ///< Флаг отмены загрузки
 
  public:
   /**
@@ -52,10 +221,14 @@ class Parser {
   /**
    * @brief Загружает файл по указанному пути
    *
-   * Если файл не удаётся загрузить по какой-либо причине,
-   * загружает предыдущие данные и выбрасывает исключение.
+   * После разбора и валидации рёбра граней заменяются уникальными
+   * неориентированными рёбрами, а в `ObjectData::stats` записываются число
+   * вершин, рёбер и граней. Если файл не удаётся загрузить по какой-либо
+   * причине или загрузка отменена, загружает предыдущие данные и выбрасывает
+   * исключение.
    *
    * @param path Путь к файлу
+   * @throws LoadCanceled Если во время загрузки установлен флаг отмены
    */
 
   void LoadFile(const std::string& path);
@@ -70,6 +243,60 @@ class Parser {
 
   const ObjectData& GetData();
 
+  /**
+   * @brief Забирает текущие данные
+   *
+   * Переносит данные парсера без копирования; после вызова данные парсера
+   * пусты.
+   *
+   * @return Данные объекта
+   */
+  ObjectData TakeData();
+
+  /**
+   * @brief Устанавливает режим чтения файла
+   *
+   * @param mode Режим чтения, используемый при следующих загрузках
+   */
+  void SetLoadMode(LoadMode mode);
+
+  /**
+   * @brief Возвращает текущий режим чтения файла
+   *
+   * @return Режим чтения
+   */
+  LoadMode GetLoadMode() const;
+
+  /**
+   * @brief Устанавливает число частей разбора в режиме отображения
+   *
+   * Части разбираются в общем пуле потоков `ThreadPool`.
+   *
+   * @param count Число частей; 0 означает размер пула
+   */
+  void SetThreadCount(unsigned int count);
+
+  /**
+   * @brief Устанавливает получателя хода загрузки
+   *
+   * Функция вызывается примерно через каждые `kProgressStep` разобранных
+   * байтов и один раз по завершении разбора. Она может вызываться из потоков
+   * разбора, но никогда не вызывается одновременно из нескольких потоков.
+   *
+   * @param callback Получатель хода загрузки; пустая функция отключает отчёты
+   */
+  void SetProgressCallback(ProgressCallback callback);
+
+  /**
+   * @brief Устанавливает флаг отмены загрузки
+   *
+   * Флаг проверяется вместе с отчётами о ходе загрузки и перед построением
+   * рёбер. Флаг должен существовать, пока идёт загрузка.
+   *
+   * @param cancel Указатель на флаг отмены или nullptr
+   */
+  void SetCancelFlag(const std::atomic<bool>* cancel);
+
  private:
   /**
    * @brief Читает данные из файла по пути
@@ -77,19 +304,106 @@ class Parser {
    * Открывает поток для указанного пути и начинает парсить данные.
    *
    * @param path Путь к файлу
+   * @param progress Состояние хода загрузки
+   */
+  void ReadData(const std::string& path, ProgressState& progress);
+
+  /**
+   * @brief Резервирует пространство для векторов по размеру данных
+   *
+   * Число координат и индексов оценивается пропорционально их доле в
+   * выборке с запасом в 1/8, поэтому файл не читается дважды. Если в выборке
+   * нет ни вершин, ни граней, используются `kBytesPerCoordinate` и
+   * `kBytesPerIndex`.
+   *
+   * @param bytes Размер разбираемых данных в байтах
+   * @param mix Состав строк выборки
+   * @param vertices Вектор вершин
+   * @param faces Вектор рёбер
    */
-  void ReadData(const std::string& path);
+  static void ReserveSpace(std::size_t bytes, const LineMix& mix,
+                           std::vector<float>& vertices,
+                           std::vector<unsigned int>& faces);
 
   /**
-   * @brief Читает строки в потоке и резервирует пространство для векторов
+   * @brief Учитывает в составе строк целые строки участка
    *
-   * Читает строки в потоке по одной и подсчитывает все данные.
-   * Затем резервирует пространство для векторов в объектных данных.
-   * Возвращает поток в начало и очищает все флаги ошибок.
+   * Участок должен начинаться с начала строки; незавершённая последняя
+   * строка не учитывается.
    *
-   * @param stream Входной поток
+   * @param begin Начало участка
+   * @param end Конец участка
+   * @param mix Состав строк, дополняемый строками участка
    */
-  void ReserveSpace(std::ifstream& in);
+  static void CountLineMix(const char* begin, const char* end, LineMix& mix);
+
+  /**
+   * @brief Оценивает состав строк данных по `kReserveSamples` участкам
+   * @param begin Начало данных
+   * @param end Конец данных
+   * @return Состав строк выборки
+   */
+  static LineMix SampleLineMix(const char* begin, const char* end);
+
+  /**
+   * @brief Читает данные из файла, отображённого в память
+   *
+   * Отображает файл в память, делит его на фрагменты, разбирает их
+   * параллельно и склеивает результаты.
+   *
+   * @param path Путь к файлу
+   * @param progress Состояние хода загрузки
+   */
+  void ReadMappedData(const std::string& path, ProgressState& progress);
+
+  /**
+   * @brief Определяет число фрагментов для разбора файла
+   *
+   * @param file Отображённый файл
+   * @return Число фрагментов (не меньше одного)
+   */
+  unsigned int ChunkCount(const MappedFile& file) const;
+
+  /**
+   * @brief Делит байтовый диапазон на фрагменты по границам строк
+   *
+   * @param begin Начало данных файла
+   * @param end Конец данных файла
+   * @param count Желаемое число фрагментов
+   * @return Фрагменты в порядке следования в файле
+   */
+  static std::vector<Chunk> SplitChunks(const char* begin, const char* end,
+                                        unsigned int count);
+
+  /**
+   * @brief Разбирает строки одного фрагмента
+   *
+   * @param chunk Фрагмент, в который записывается результат
+   */
+  static void ParseChunk(Chunk& chunk);
+
+  /**
+   * @brief Склеивает фрагменты в данные объекта
+   *
+   * Поправляет относительные индексы граней на число вершин в предыдущих
+   * фрагментах, переносит данные в порядке следования фрагментов и
+   * объединяет их габариты и диапазоны индексов в `extents_`.
+   *
+   * @param chunks Разобранные фрагменты
+   */
+  void MergeChunks(std::vector<Chunk>& chunks);
+
+  /**
+   * @brief Учитывает разобранную часть файла и сообщает ход загрузки
+   *
+   * @param progress Состояние хода загрузки
+   * @param bytes Число байтов, разобранных с прошлого отчёта
+   * @param vertices Число вершин, прочитанных с прошлого отчёта
+   * @param faces Число граней, прочитанных с прошлого отчёта
+   * @throws LoadCanceled Если установлен флаг отмены
+   */
+  static void ReportProgress(ProgressState& progress, std::size_t bytes,
+                             std::size_t vertices, std::size_t faces);
 
   /**
    * @brief Парсит вершины
@@ -101,6 +415,15 @@ class Parser {
 
   void ParseVertex(const std::string& line);
 
+  /**
+   * @brief Парсит вершины из байтового диапазона строки
+   *
+   * @param begin Указатель на символ, следующий за 'v'
+   * @param end Конец строки
+   * @param chunk Фрагмент, в который добавляются вершины
+   */
+  static void ParseVertex(const char* begin, const char* end, Chunk& chunk);
+
   /**
    * @brief Парсит грани
    *
@@ -111,11 +434,41 @@ class Parser {
    */
   void ParseFaces(const std::string& line);
 
+  /**
+   * @brief Парсит грани из байтового диапазона строки
+   *
+   * Отрицательные индексы разрешаются относительно вершин фрагмента, а их
+   * позиции запоминаются для поправки при склейке.
+   *
+   * @param begin Указатель на символ, следующий за 'f'
+   * @param end Конец строки
+   * @param chunk Фрагмент, в который добавляются рёбра
+   */
+  static void ParseFaces(const char* begin, const char* end, Chunk& chunk);
+
+  /**
+   * @brief Учитывает координату вершины в габаритах
+   *
+   * @param extents Габариты
+   * @param axis Ось координаты (0 - x, 1 - y, 2 - z)
+   * @param value Значение координаты
+   */
+  static void AddCoordinate(Extents& extents, std::size_t axis, float value);
+
+  /**
+   * @brief Учитывает индекс вершины в диапазоне индексов
+   *
+   * @param extents Габариты и диапазон индексов
+   * @param index Индекс вершины, отсчитываемый с нуля
+   */
+  static void AddIndex(Extents& extents, long long index);
+
   /**
    * @brief Валидация данных
    *
-   * Простой проверочный механизм, есть ли в данных грань, указывающая на
-   * несуществующую вершину.
+   * Проверяет, есть ли в данных грань, указывающая на несуществующую вершину.
+   * Диапазон индексов собран при разборе, поэтому индексы не обходятся
+   * повторно.
    *
    * @throws std::logic_error Если данные некорректны
    */
@@ -0,0 +1,345 @@
+/**
+ * @file batch_renderer.cc
+ * @brief Реализация класса BatchRenderer.
+ */
+
+#include "batch_renderer.h"
+
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../concurrency/thread_pool.h"
+#include "../model.h"
+#include "../parser/float_chars.h"
+#include "image_writer.h"
+
+namespace s21 {
+
+namespace {
+
+const char kUsage[] =
+    "Usage: 3DViewer_batch [options] [view options] [--view NAME [view "
+    "options]]... FILE.obj...\n"
+    "\n"
+    "Renders wireframe previews of OBJ models without a display.\n"
+    "\n"
+    "Options:\n"
+    "  -h, --help               show this help\n"
+    "  -o, --output DIR         output directory (default: .)\n"
+    "  --cache                  read and write the binary mesh cache\n"
+    "  --view NAME              start a view; the output file gets the\n"
+    "                           suffix _NAME\n"
+    "\n"
+    "View options (before the first --view they apply to every view):\n"
+    "  --size WxH               frame size (default: 640x480)\n"
+    "  --format png|gif         still image or a full turn around Y\n"
+    "  --move X,Y,Z             translation\n"
+    "  --rotate X,Y,Z           rotation in degrees\n"
+    "  --scale K                uniform scale (default: 1)\n"
+    "  --projection parallel|central\n"
+    "  --background RRGGBB      background color (default: 000000)\n"
+    "  --edges-color RRGGBB     edge color (default: ffffff)\n"
+    "  --edges-size N           edge width in pixels (default: 1)\n"
+    "  --edges-type solid|dashed\n"
+    "  --vertex-color RRGGBB    vertex color (default: ffffff)\n"
+    "  --vertex-size N          vertex size in pixels (default: 5)\n"
+    "  --vertex-shape none|round|square\n"
+    "  --frames N               GIF frames per turn (default: 36)\n"
+    "  --delay N                GIF frame delay in 1/100 s (default: 10)\n"
+    "  --dither none|ordered|floyd-steinberg\n"
+    "                           GIF palette dithering (default: none)\n";
+
+template <typename Number>
+Number ParseNumber(const std::string &option, const std::string &text) {
+  Number value{};
+  const char *end = text.data() + text.size();
+  std::from_chars_result result;
+  if constexpr (std::is_floating_point_v<Number>) {
+    result = FloatFromChars(text.data(), end, value);
+  } else {
+    result = std::from_chars(text.data(), end, value);
+  }
+  if (result.ec != std::errc() || result.ptr != end) {
+    throw std::invalid_argument("Invalid value for " + option + ": " + text);
+  }
+  return value;
+}
+
+int ParsePositive(const std::string &option, const std::string &text) {
+  int value = ParseNumber<int>(option, text);
+  if (value <= 0) {
+    throw std::invalid_argument(option + " must be positive: " + text);
+  }
+  return value;
+}
+
+Delta ParseDelta(const std::string &option, const std::string &text) {
+  std::size_t first = text.find(',');
+  std::size_t second =
+      first == std::string::npos ? first : text.find(',', first + 1);
+  if (second == std::string::npos) {
+    throw std::invalid_argument(option + " expects X,Y,Z: " + text);
+  }
+  std::string y = text.substr(first + 1, second - first - 1);
+  return {ParseNumber<float>(option, text.substr(0, first)),
+          ParseNumber<float>(option, y),
+          ParseNumber<float>(option, text.substr(second + 1))};
+}
+
+Rgba ParseColor(const std::string &option, const std::string &text) {
+  std::string hex = !text.empty() && text[0] == '#' ? text.substr(1) : text;
+  unsigned int value = 0;
+  const char *end = hex.data() + hex.size();
+  auto [ptr, error] = std::from_chars(hex.data(), end, value, 16);
+  if (hex.size() != 6 || error != std::errc() || ptr != end) {
+    throw std::invalid_argument(option + " expects RRGGBB: " + text);
+  }
+  return {static_cast<std::uint8_t>(value >> 16),
+          static_cast<std::uint8_t>(value >> 8),
+          static_cast<std::uint8_t>(value), 255};
+}
+
+/**
+ * @brief Применяет параметр вида
+ * @return false, если параметр не относится к виду
+ */
+bool ApplyViewOption(const std::string &option, const std::string &value,
+                     BatchView &view) {
+  auto invalid = [&] {
+    return std::invalid_argument("Invalid value for " + option + ": " +
+                                 value);
+  };
+  if (option == "--size") {
+    std::size_t x = value.find('x');
+    if (x == std::string::npos) throw invalid();
+    view.width = ParsePositive(option, value.substr(0, x));
+    view.height = ParsePositive(option, value.substr(x + 1));
+  } else if (option == "--format") {
+    if (value != "png" && value != "gif") throw invalid();
+    view.format = value == "png" ? ImageFormat::kPng : ImageFormat::kGif;
+  } else if (option == "--move") {
+    view.move = ParseDelta(option, value);
+  } else if (option == "--rotate") {
+    view.rotation = ParseDelta(option, value);
+  } else if (option == "--scale") {
+    view.scale = ParseNumber<float>(option, value);
+    if (!(view.scale > 0)) throw invalid();
+  } else if (option == "--projection") {
+    if (value != "parallel" && value != "central") throw invalid();
+    view.settings.parallel_projection = value == "parallel";
+  } else if (option == "--background") {
+    view.settings.background = ParseColor(option, value);
+  } else if (option == "--edges-color") {
+    view.settings.edges_color = ParseColor(option, value);
+  } else if (option == "--edges-size") {
+    view.settings.edges_size = ParsePositive(option, value);
+  } else if (option == "--edges-type") {
+    if (value != "solid" && value != "dashed") throw invalid();
+    view.settings.dashed_edges = value == "dashed";
+  } else if (option == "--vertex-color") {
+    view.settings.vertex_color = ParseColor(option, value);
+  } else if (option == "--vertex-size") {
+    view.settings.vertex_size = ParsePositive(option, value);
+  } else if (option == "--vertex-shape") {
+    if (value == "none") {
+      view.settings.vertex_shape = PointShape::kNone;
+    } else if (value == "round") {
+      view.settings.vertex_shape = PointShape::kRound;
+    } else if (value == "square") {
+      view.settings.vertex_shape = PointShape::kSquare;
+    } else {
+      throw invalid();
+    }
+  } else if (option == "--frames") {
+    view.frames = ParsePositive(option, value);
+  } else if (option == "--delay") {
+    view.delay = ParseNumber<int>(option, value);
+    if (view.delay < 0) throw invalid();
+  } else if (option == "--dither") {
+    if (value == "none") {
+      view.dither = GifDither::kNone;
+    } else if (value == "ordered") {
+      view.dither = GifDither::kOrdered;
+    } else if (value == "floyd-steinberg") {
+      view.dither = GifDither::kFloydSteinberg;
+    } else {
+      throw invalid();
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Проверяет, что имена результатов разных входных файлов различны
+ *
+ * Имя результата строится по имени файла без каталога и расширения, а файлы
+ * отрисовываются параллельно, поэтому `a/cube.obj` и `b/cube.obj` писали бы
+ * один и тот же файл одновременно.
+ *
+ * @throws std::invalid_argument Если два входных файла дают одно имя
+ */
+void CheckOutputNames(const std::vector<std::string> &inputs) {
+  std::map<std::string, const std::string *> names;
+  for (const std::string &input : inputs) {
+    std::string name = std::filesystem::path(input).stem().string();
+    auto [it, inserted] = names.emplace(name, &input);
+    if (!inserted) {
+      throw std::invalid_argument("Inputs " + *it->second + " and " + input +
+                                  " have the same output name " + name);
+    }
+  }
+}
+
+float Radians(float degrees) {
+  return static_cast<float>(degrees * M_PI / 180.0);
+}
+
+}  // namespace
+
+BatchRenderer::BatchRenderer(BatchOptions options)
+    : options_(std::move(options)) {
+  if (options_.views.empty()) options_.views.emplace_back();
+}
+
+BatchOptions BatchRenderer::ParseArguments(
+    const std::vector<std::string> &args) {
+  BatchOptions options;
+  BatchView defaults;
+  for (std::size_t i = 0; i < args.size(); ++i) {
+    const std::string &arg = args[i];
+    if (arg == "-h" || arg == "--help") {
+      options.help = true;
+      return options;
+    }
+    if (arg.size() < 2 || arg[0] != '-') {
+      options.inputs.push_back(arg);
+      continue;
+    }
+    if (arg == "--cache") {
+      options.use_cache = true;
+      continue;
+    }
+    if (i + 1 == args.size()) {
+      throw std::invalid_argument("Missing value for " + arg);
+    }
+    const std::string &value = args[++i];
+    if (arg == "-o" || arg == "--output") {
+      options.output_dir = value;
+    } else if (arg == "--view") {
+      if (value.empty() || value.find_first_of("/\\") != std::string::npos) {
+        throw std::invalid_argument("Invalid view name: " + value);
+      }
+      for (const BatchView &view : options.views) {
+        if (view.name == value) {
+          throw std::invalid_argument("Duplicate view name: " + value);
+        }
+      }
+      options.views.push_back(defaults);
+      options.views.back().name = value;
+    } else if (!ApplyViewOption(
+                   arg, value,
+                   options.views.empty() ? defaults : options.views.back())) {
+      throw std::invalid_argument("Unknown option: " + arg);
+    }
+  }
+  if (options.inputs.empty()) {
+    throw std::invalid_argument("No input files");
+  }
+  if (options.views.empty()) options.views.push_back(defaults);
+  for (const BatchView &view : options.views) {
+    if (view.format == ImageFormat::kGif &&
+        (view.width > GifEncoder::kMaxSize ||
+         view.height > GifEncoder::kMaxSize)) {
+      throw std::invalid_argument("GIF frame size must not exceed 65535x65535");
+    }
+  }
+  CheckOutputNames(options.inputs);
+  return options;
+}
+
+const char *BatchRenderer::Usage() { return kUsage; }
+
+std::vector<BatchResult> BatchRenderer::Run(
+    const ReportCallback &report) const {
+  CheckOutputNames(options_.inputs);
+  std::filesystem::create_directories(options_.output_dir);
+  std::vector<BatchResult> results(options_.inputs.size());
+  std::mutex report_mutex;
+  ThreadPool::Instance().Run(results.size(), [&](std::size_t i) {
+    results[i] = RenderFile(options_.inputs[i]);
+    if (report) {
+      std::lock_guard<std::mutex> lock(report_mutex);
+      report(results[i]);
+    }
+  });
+  return results;
+}
+
+BatchResult BatchRenderer::RenderFile(const std::string &input) const {
+  auto start = std::chrono::steady_clock::now();
+  BatchResult result;
+  result.input = input;
+  try {
+    ObjectData data = Model::ReadFile(input, options_.use_cache);
+    SoftwareRenderer renderer;
+    for (const BatchView &view : options_.views) {
+      Model model;
+      model.SetTransformMode(TransformMode::kRetained);
+      model.SetData(data);
+      TransformParametrs delta{
+          {view.scale, view.scale, view.scale},
+          view.move,
+          {Radians(view.rotation.x), Radians(view.rotation.y),
+           Radians(view.rotation.z)}};
+      model.Transform(delta);
+
+      std::string path = OutputPath(input, view);
+      auto render = [&] {
+        renderer.Render(view.width, view.height, model.GetVertices(),
+                        model.GetFaces(), model.GetModelMatrix(),
+                        view.settings);
+      };
+      if (view.format == ImageFormat::kPng) {
+        render();
+        WritePng(path, view.width, view.height, renderer.Pixels());
+      } else {
+        GifEncoder gif(path, view.width, view.height, view.delay,
+                       view.dither);
+        TransformParametrs turn{
+            {0, 0, 0}, {0, 0, 0}, {0, Radians(360.0f / view.frames), 0}};
+        for (int frame = 0; frame < view.frames; ++frame) {
+          if (frame) model.Transform(turn);
+          render();
+          gif.AddFrame(renderer.Pixels());
+        }
+        gif.Finish();
+      }
+      result.outputs.push_back(path);
+    }
+  } catch (const std::exception &e) {
+    result.error = e.what();
+  }
+  result.seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  return result;
+}
+
+std::string BatchRenderer::OutputPath(const std::string &input,
+                                      const BatchView &view) const {
+  std::string name = std::filesystem::path(input).stem().string();
+  if (!view.name.empty()) name += "_" + view.name;
+  name += view.format == ImageFormat::kPng ? ".png" : ".gif";
+  return (std::filesystem::path(options_.output_dir) / name).string();
+}
+
+}  // namespace s21
@@ -0,0 +1,159 @@
+/**
+ * @file batch_renderer.h
+ * @brief Заголовочный файл для пакетной отрисовки моделей без интерфейса.
+ *
+ * `BatchRenderer` загружает OBJ-файлы, применяет к каждой модели один или
+ * несколько наборов трансформаций и настроек камеры (видов) и сохраняет
+ * кадры `SoftwareRenderer` в PNG или анимированный GIF. Окна, виджеты и
+ * контекст OpenGL не создаются, поэтому отрисовка работает на сервере без
+ * дисплея.
+ *
+ * Модели обрабатываются параллельно задачами `ThreadPool`: каждая задача
+ * читает файл один раз и рисует все виды своим `SoftwareRenderer`. Разбор
+ * файла и отрисовка кадра сами распределяются по тому же пулу, поэтому
+ * потоки заняты и при одной большой модели, и при множестве маленьких.
+ */
+
+#ifndef BATCH_RENDERER_H_
+#define BATCH_RENDERER_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../affine_transform/factory.h"
+#include "image_writer.h"
+#include "software_renderer.h"
+
+namespace s21 {
+
+/**
+ * Формат выходного файла
+ */
+enum class ImageFormat {
+  kPng,  ///< Один кадр PNG
+  kGif   ///< Оборот модели вокруг оси Y в анимированном GIF
+};
+
+/**
+ * Вид: трансформация модели, параметры камеры и формат результата
+ */
+
+struct BatchView {
+  std::string name{};                      ///< Суффикс имени файла
+  int width = 640;                         ///< Ширина кадра
+  int height = 480;                        ///< Высота кадра
+  ImageFormat format = ImageFormat::kPng;  ///< Формат файла
+  Delta move{0, 0, 0};                     ///< Перемещение
+  Delta rotation{0, 0, 0};                 ///< Поворот в градусах
+  float scale = 1;                         ///< Масштаб
+  RenderSettings settings{};  ///< Цвета, линии, вершины и проекция
+  int frames = 36;            ///< Число кадров GIF на полный оборот
+  int delay = 10;  ///< Задержка между кадрами GIF в сотых долях секунды
+  GifDither dither = GifDither::kNone;  ///< Приведение цветов GIF к палитре
+};
+
+/**
+ * Параметры пакетной отрисовки
+ */
+
+struct BatchOptions {
+  std::vector<std::string> inputs{};  ///< OBJ-файлы
+  std::vector<BatchView> views{};     ///< Виды, рисуемые для каждой модели
+  std::string output_dir = ".";       ///< Каталог для результатов
+  bool use_cache = false;             ///< Использовать двоичный кэш моделей
+  bool help = false;                  ///< Запрошена справка
+};
+
+/**
+ * Результат обработки одного файла
+ */
+
+struct BatchResult {
+  std::string input{};                 ///< OBJ-файл
+  std::vector<std::string> outputs{};  ///< Записанные файлы
+  std::string error{};                 ///< Описание ошибки или пустая строка
+  double seconds = 0;                  ///< Время загрузки и отрисовки
+};
+
+/**
+ * @class BatchRenderer
+ * @brief Отрисовка набора моделей в файлы изображений.
+ */
+class BatchRenderer {
+ public:
+  /// Получатель результатов по мере готовности моделей
+  using ReportCallback = std::function<void(const BatchResult &)>;
+
+  /**
+   * @brief Создаёт отрисовку с заданными параметрами
+   * @param options Параметры; пустой список видов заменяется видом по
+   * умолчанию
+   */
+  explicit BatchRenderer(BatchOptions options);
+
+  /**
+   * @brief Разбирает аргументы командной строки
+   *
+   * Параметры вида до первого `--view` задают значения по умолчанию, каждый
+   * `--view NAME` начинает новый вид с этими значениями, а следующие за ним
+   * параметры вида относятся только к нему. Остальные аргументы считаются
+   * путями к OBJ-файлам.
+   *
+   * @param args Аргументы без имени программы
+   * @return Параметры пакетной отрисовки
+   * @throws std::invalid_argument Если аргумент неизвестен, значение
+   * некорректно, размер кадра GIF больше `GifEncoder::kMaxSize` или два
+   * входных файла дают одно имя результата
+   */
+  static BatchOptions ParseArguments(const std::vector<std::string> &args);
+
+  /**
+   * @brief Возвращает справку по аргументам командной строки
+   * @return Текст справки
+   */
+  static const char *Usage();
+
+  /**
+   * @brief Отрисовывает все модели
+   *
+   * Создаёт каталог результатов и обрабатывает файлы параллельно. Ошибка в
+   * одном файле записывается в его результат и не прерывает остальные.
+   *
+   * @param report Получатель результатов; вызывается из рабочих потоков, но
+   * не одновременно
+   * @return Результаты в порядке входных файлов
+   * @throws std::invalid_argument Если два входных файла дают одно имя
+   * результата
+   * @throws std::filesystem::filesystem_error Если каталог результатов не
+   * удаётся создать
+   */
+  std::vector<BatchResult> Run(const ReportCallback &report = {}) const;
+
+  /**
+   * @brief Загружает одну модель и рисует все её виды
+   * @param input Путь к OBJ-файлу
+   * @return Результат обработки файла
+   */
+  BatchResult RenderFile(const std::string &input) const;
+
+  /**
+   * @brief Возвращает путь к файлу результата
+   *
+   * Имя составляется из имени модели без расширения, суффикса вида через
+   * `_` и расширения формата.
+   *
+   * @param input Путь к OBJ-файлу
+   * @param view Вид
+   * @return Путь внутри каталога результатов
+   */
+  std::string OutputPath(const std::string &input,
+                         const BatchView &view) const;
+
+ private:
+  BatchOptions options_;  ///< Параметры отрисовки
+};
+
+}  // namespace s21
+
+#endif  // BATCH_RENDERER_H_
@@ -0,0 +1,63 @@
+/**
+ * @file gif_recorder.cc
+ * @brief Реализация класса GifRecorder.
+ */
+
+#include "gif_recorder.h"
+
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+namespace s21 {
+
+GifRecorder::GifRecorder(const std::string &path, int width, int height,
+                         int delay, FinishedCallback finished,
+                         std::size_t capacity)
+    : encoder_(path, width, height, delay),
+      queue_(capacity),
+      finished_(std::move(finished)),
+      frame_bytes_(static_cast<std::size_t>(width) * height * 4),
+      worker_([this] { EncodeLoop(); }) {}
+
+GifRecorder::~GifRecorder() {
+  Close();
+  Wait();
+}
+
+bool GifRecorder::Push(std::vector<std::uint8_t> rgba) {
+  if (rgba.size() != frame_bytes_) {
+    throw std::invalid_argument("Pixel buffer does not match GIF size");
+  }
+  return queue_.Push(std::move(rgba));
+}
+
+GifRecorder::PushResult GifRecorder::TryPush(std::vector<std::uint8_t> rgba) {
+  if (rgba.size() != frame_bytes_) {
+    throw std::invalid_argument("Pixel buffer does not match GIF size");
+  }
+  if (queue_.TryPush(rgba)) return PushResult::kQueued;
+  return queue_.IsClosed() ? PushResult::kClosed : PushResult::kDropped;
+}
+
+void GifRecorder::Close() { queue_.Close(); }
+
+void GifRecorder::Wait() {
+  if (worker_.joinable()) worker_.join();
+}
+
+void GifRecorder::EncodeLoop() {
+  std::string error;
+  try {
+    while (auto frame = queue_.Pop()) encoder_.AddFrame(*frame);
+  } catch (const std::exception &e) {
+    // Захват больше не ждёт места в очереди: Push вернёт false.
+    error = e.what();
+    queue_.Close();
+    queue_.Clear();
+  }
+  encoder_.Finish();
+  if (finished_) finished_(error);
+}
+
+}  // namespace s21
@@ -0,0 +1,130 @@
+/**
+ * @file gif_recorder.h
+ * @brief Заголовочный файл для записи GIF в рабочем потоке.
+ *
+ * `GifRecorder` отделяет захват кадров от их кодирования. Захват кладёт
+ * готовые кадры RGBA в `BoundedQueue`, а рабочий поток строит палитру,
+ * квантует кадр и сжимает его LZW через `GifEncoder`. Поток, захватывающий
+ * кадры, ждёт в `Push` только когда очередь заполнена, то есть когда
+ * кодирование отстало больше чем на её ёмкость; `TryPush` в этом случае
+ * отбрасывает кадр, не блокируя вызывающий поток.
+ *
+ * Кадры кодируются одним потоком по порядку: каждый кадр GIF записывается
+ * как разность с предыдущим.
+ */
+
+#ifndef GIF_RECORDER_H_
+#define GIF_RECORDER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../concurrency/bounded_queue.h"
+#include "image_writer.h"
+
+namespace s21 {
+
+/**
+ * @class GifRecorder
+ * @brief Кодирование кадров анимированного GIF в рабочем потоке.
+ */
+class GifRecorder {
+ public:
+  /// Получатель результата: пустая строка или описание ошибки
+  using FinishedCallback = std::function<void(const std::string &error)>;
+
+  /// Ёмкость очереди кадров по умолчанию
+  static constexpr std::size_t kDefaultCapacity = 8;
+
+  /**
+   * Результат `TryPush`
+   */
+  enum class PushResult {
+    kQueued,   ///< Кадр передан на кодирование
+    kDropped,  ///< Очередь заполнена, кадр отброшен
+    kClosed    ///< Запись закрыта или прервана ошибкой
+  };
+
+  /**
+   * @brief Открывает файл и запускает рабочий поток
+   *
+   * @param path Путь к файлу
+   * @param width Ширина кадров
+   * @param height Высота кадров
+   * @param delay Задержка между кадрами в сотых долях секунды
+   * @param finished Получатель результата; вызывается из рабочего потока
+   * после закрытия файла
+   * @param capacity Наибольшее число кадров, ожидающих кодирования
+   * @throws std::invalid_argument Если размер кадра не положителен
+   * @throws std::runtime_error Если файл не удаётся открыть
+   */
+  GifRecorder(const std::string &path, int width, int height, int delay,
+              FinishedCallback finished = {},
+              std::size_t capacity = kDefaultCapacity);
+
+  /**
+   * @brief Закрывает очередь и дожидается записи оставшихся кадров
+   */
+  ~GifRecorder();
+
+  GifRecorder(const GifRecorder &) = delete;
+  GifRecorder &operator=(const GifRecorder &) = delete;
+
+  /**
+   * @brief Передаёт кадр на кодирование
+   *
+   * Ждёт, если в очереди уже `capacity` кадров.
+   *
+   * @param rgba Пиксели RGBA размером width * height * 4, строки сверху вниз
+   * @return false, если запись закрыта или прервана ошибкой
+   * @throws std::invalid_argument Если размер буфера не соответствует кадру
+   */
+  bool Push(std::vector<std::uint8_t> rgba);
+
+  /**
+   * @brief Передаёт кадр на кодирование, не дожидаясь места в очереди
+   *
+   * Подходит для потока интерфейса: если кодирование отстало больше чем на
+   * `capacity` кадров, кадр отбрасывается.
+   *
+   * @param rgba Пиксели RGBA размером width * height * 4, строки сверху вниз
+   * @return Принят, отброшен ли кадр или запись уже закрыта
+   * @throws std::invalid_argument Если размер буфера не соответствует кадру
+   */
+  PushResult TryPush(std::vector<std::uint8_t> rgba);
+
+  /**
+   * @brief Завершает приём кадров, не дожидаясь кодирования
+   *
+   * Рабочий поток кодирует оставшиеся кадры, закрывает файл и вызывает
+   * получатель результата.
+   */
+  void Close();
+
+  /**
+   * @brief Дожидается завершения рабочего потока
+   *
+   * Должен вызываться после `Close`, иначе ожидание не закончится.
+   */
+  void Wait();
+
+ private:
+  /**
+   * @brief Цикл рабочего потока
+   */
+  void EncodeLoop();
+
+  GifEncoder encoder_;                             ///< Файл GIF
+  BoundedQueue<std::vector<std::uint8_t>> queue_;  ///< Ожидающие кадры
+  FinishedCallback finished_;                      ///< Получатель результата
+  std::size_t frame_bytes_;                        ///< Размер кадра в байтах
+  std::thread worker_;                             ///< Рабочий поток
+};
+
+}  // namespace s21
+
+#endif  // GIF_RECORDER_H_
@@ -0,0 +1,259 @@
+/**
+ * @file image_writer.cc
+ * @brief Реализация записи кадров в файлы PNG и GIF.
+ */
+
+#include "image_writer.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <stdexcept>
+
+#include "../concurrency/thread_pool.h"
+
+// Палитра и квантование кадра GIF распределяются по общему пулу потоков.
+#define GIF_PARALLEL_FOR(count, task)                                          \
+  s21::ThreadPool::Instance().Run((count), [&](std::size_t gifTask) {          \
+    (task)(static_cast<int>(gifTask));                                         \
+  })
+#include "../../libs/gif.h"
+
+namespace s21 {
+
+namespace {
+
+/// Наибольшая длина повтора deflate
+constexpr std::size_t kMaxRun = 258;
+
+std::size_t FrameBytes(int width, int height) {
+  if (width <= 0 || height <= 0) {
+    throw std::invalid_argument("Image size must be positive");
+  }
+  return static_cast<std::size_t>(width) * height * 4;
+}
+
+std::uint32_t Crc32(const std::uint8_t *data, std::size_t size,
+                    std::uint32_t crc = 0) {
+  static const std::array<std::uint32_t, 256> table = [] {
+    std::array<std::uint32_t, 256> result{};
+    for (std::uint32_t n = 0; n < 256; ++n) {
+      std::uint32_t c = n;
+      for (int k = 0; k < 8; ++k) c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      result[n] = c;
+    }
+    return result;
+  }();
+  crc = ~crc;
+  for (std::size_t i = 0; i < size; ++i) {
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+std::uint32_t Adler32(const std::vector<std::uint8_t> &data) {
+  // 5552 - наибольшее число шагов, при котором сумма не переполняет 32 бита.
+  std::uint32_t a = 1, b = 0;
+  for (std::size_t begin = 0; begin < data.size(); begin += 5552) {
+    std::size_t end = std::min(data.size(), begin + 5552);
+    for (std::size_t i = begin; i < end; ++i) {
+      a += data[i];
+      b += a;
+    }
+    a %= 65521;
+    b %= 65521;
+  }
+  return (b << 16) | a;
+}
+
+/**
+ * Запись битов deflate: младший бит байта идёт первым
+ */
+class BitWriter {
+ public:
+  explicit BitWriter(std::vector<std::uint8_t> &out) : out_(out) {}
+
+  void Bits(std::uint32_t value, int count) {
+    buffer_ |= value << used_;
+    used_ += count;
+    while (used_ >= 8) {
+      out_.push_back(static_cast<std::uint8_t>(buffer_));
+      buffer_ >>= 8;
+      used_ -= 8;
+    }
+  }
+
+  /// Коды Хаффмана записываются со старшего бита
+  void Code(std::uint32_t code, int length) {
+    std::uint32_t reversed = 0;
+    for (int i = 0; i < length; ++i) {
+      reversed |= ((code >> i) & 1) << (length - 1 - i);
+    }
+    Bits(reversed, length);
+  }
+
+  /// Символ алфавита литералов и длин с фиксированными кодами
+  void Symbol(int symbol) {
+    if (symbol < 144) {
+      Code(0x30 + symbol, 8);
+    } else if (symbol < 256) {
+      Code(0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+      Code(symbol - 256, 7);
+    } else {
+      Code(0xC0 + symbol - 280, 8);
+    }
+  }
+
+  /// Повтор предыдущего байта: длина от 3 до 258, расстояние 1
+  void Run(std::size_t length) {
+    static const std::array<std::uint16_t, 29> base{
+        3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+        31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    static const std::array<std::uint8_t, 29> extra{
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+        2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    int code = 28;
+    while (base[code] > length) --code;
+    Symbol(257 + code);
+    Bits(static_cast<std::uint32_t>(length - base[code]), extra[code]);
+    Code(0, 5);
+  }
+
+  void Flush() {
+    if (used_) out_.push_back(static_cast<std::uint8_t>(buffer_));
+    buffer_ = 0;
+    used_ = 0;
+  }
+
+ private:
+  std::vector<std::uint8_t> &out_;
+  std::uint32_t buffer_ = 0;
+  int used_ = 0;
+};
+
+std::vector<std::uint8_t> Deflate(const std::vector<std::uint8_t> &data) {
+  std::vector<std::uint8_t> out{0x78, 0x01};
+  BitWriter writer(out);
+  writer.Bits(1, 1);  // последний блок
+  writer.Bits(1, 2);  // фиксированные коды
+  for (std::size_t i = 0; i < data.size();) {
+    std::size_t run = 0;
+    if (i > 0) {
+      std::size_t limit = std::min(kMaxRun, data.size() - i);
+      while (run < limit && data[i + run] == data[i - 1]) ++run;
+    }
+    if (run >= 3) {
+      writer.Run(run);
+      i += run;
+    } else {
+      writer.Symbol(data[i++]);
+    }
+  }
+  writer.Symbol(256);
+  writer.Flush();
+  std::uint32_t adler = Adler32(data);
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    out.push_back(static_cast<std::uint8_t>(adler >> shift));
+  }
+  return out;
+}
+
+void PutUint32(std::vector<std::uint8_t> &out, std::uint32_t value) {
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    out.push_back(static_cast<std::uint8_t>(value >> shift));
+  }
+}
+
+void PutChunk(std::ofstream &file, const char *type,
+              const std::vector<std::uint8_t> &data) {
+  std::vector<std::uint8_t> chunk(type, type + 4);
+  chunk.insert(chunk.end(), data.begin(), data.end());
+  std::uint32_t size = static_cast<std::uint32_t>(data.size());
+  std::uint32_t crc = Crc32(chunk.data(), chunk.size());
+  std::vector<std::uint8_t> header, footer;
+  PutUint32(header, size);
+  PutUint32(footer, crc);
+  for (const auto *part : {&header, &chunk, &footer}) {
+    file.write(reinterpret_cast<const char *>(part->data()), part->size());
+  }
+}
+
+}  // namespace
+
+void WritePng(const std::string &path, int width, int height,
+              const std::vector<std::uint8_t> &rgba) {
+  if (rgba.size() != FrameBytes(width, height)) {
+    throw std::invalid_argument("Pixel buffer does not match image size");
+  }
+  // Фильтр Sub: из каждого байта вычитается тот же канал левого пикселя.
+  std::size_t stride = static_cast<std::size_t>(width) * 4;
+  std::vector<std::uint8_t> filtered((stride + 1) * height);
+  for (int y = 0; y < height; ++y) {
+    const std::uint8_t *row = &rgba[y * stride];
+    std::uint8_t *out = &filtered[y * (stride + 1)];
+    *out++ = 1;
+    for (std::size_t i = 0; i < stride; ++i) {
+      out[i] = static_cast<std::uint8_t>(row[i] - (i >= 4 ? row[i - 4] : 0));
+    }
+  }
+
+  std::vector<std::uint8_t> header;
+  PutUint32(header, static_cast<std::uint32_t>(width));
+  PutUint32(header, static_cast<std::uint32_t>(height));
+  header.insert(header.end(), {8, 6, 0, 0, 0});  // 8 бит, RGBA
+
+  std::ofstream file(path, std::ios::binary);
+  if (!file) throw std::runtime_error("Cannot open " + path);
+  static const char kSignature[8] = {'\x89', 'P',  'N',    'G',
+                                     '\r',   '\n', '\x1a', '\n'};
+  file.write(kSignature, sizeof(kSignature));
+  PutChunk(file, "IHDR", header);
+  PutChunk(file, "IDAT", Deflate(filtered));
+  PutChunk(file, "IEND", {});
+  if (!file.flush()) throw std::runtime_error("Cannot write " + path);
+}
+
+struct GifEncoder::Impl {
+  GifWriter writer{};
+  bool open = false;
+};
+
+GifEncoder::GifEncoder(const std::string &path, int width, int height,
+                       int delay, GifDither dither)
+    : impl_(std::make_unique<Impl>()),
+      width_(width),
+      height_(height),
+      delay_(delay),
+      dither_(dither) {
+  FrameBytes(width, height);
+  if (width > kMaxSize || height > kMaxSize) {
+    throw std::invalid_argument("GIF frame size must not exceed 65535");
+  }
+  if (!GifBegin(&impl_->writer, path.c_str(), width, height, delay)) {
+    throw std::runtime_error("Cannot open " + path);
+  }
+  impl_->open = true;
+}
+
+GifEncoder::~GifEncoder() { Finish(); }
+
+void GifEncoder::AddFrame(const std::vector<std::uint8_t> &rgba) {
+  if (!impl_->open) throw std::logic_error("GIF file is already finished");
+  if (rgba.size() != FrameBytes(width_, height_)) {
+    throw std::invalid_argument("Pixel buffer does not match GIF size");
+  }
+  int dither = kGifDitherNone;
+  if (dither_ == GifDither::kFloydSteinberg) dither = kGifDitherFloydSteinberg;
+  if (dither_ == GifDither::kOrdered) dither = kGifDitherOrdered;
+  GifWriteFrame(&impl_->writer, rgba.data(), width_, height_, delay_, 8,
+                dither);
+}
+
+void GifEncoder::Finish() {
+  if (!impl_->open) return;
+  impl_->open = false;
+  GifEnd(&impl_->writer);
+}
+
+}  // namespace s21
@@ -0,0 +1,111 @@
+/**
+ * @file image_writer.h
+ * @brief Заголовочный файл для записи кадров в файлы PNG и GIF без Qt.
+ *
+ * `WritePng` сохраняет буфер RGBA в PNG. Строки кодируются фильтром Sub, а
+ * поток deflate содержит один блок с фиксированными кодами Хаффмана и
+ * повторами на расстоянии 1: после фильтра фон каркасного кадра превращается
+ * в длинные серии нулей, которые сжимаются в сотни раз без внешних
+ * библиотек.
+ *
+ * `GifEncoder` записывает анимацию через `libs/gif.h`. Функции gif.h
+ * определены прямо в заголовке, поэтому он подключается только в
+ * `image_writer.cc`.
+ */
+
+#ifndef IMAGE_WRITER_H_
+#define IMAGE_WRITER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @brief Записывает изображение в файл PNG
+ *
+ * @param path Путь к файлу
+ * @param width Ширина изображения
+ * @param height Высота изображения
+ * @param rgba Пиксели RGBA по 8 бит на канал, строки сверху вниз
+ * @throws std::invalid_argument Если размер буфера не соответствует
+ * изображению
+ * @throws std::runtime_error Если файл не удаётся записать
+ */
+void WritePng(const std::string &path, int width, int height,
+              const std::vector<std::uint8_t> &rgba);
+
+/**
+ * Способ приведения цветов кадра GIF к палитре
+ */
+enum class GifDither {
+  kNone,            ///< Ближайший цвет палитры
+  kFloydSteinberg,  ///< Рассеивание ошибки Флойда-Стейнберга
+  kOrdered          ///< Упорядоченный дизеринг матрицей Байера
+};
+
+/**
+ * @class GifEncoder
+ * @brief Запись кадров одного размера в анимированный GIF.
+ *
+ * Файл открывается в конструкторе и закрывается в `Finish` или в
+ * деструкторе.
+ */
+class GifEncoder {
+ public:
+  /// Наибольшие ширина и высота кадра: в GIF они 16-битные
+  static constexpr int kMaxSize = 65535;
+
+  /**
+   * @brief Открывает файл и записывает заголовок GIF
+   *
+   * @param path Путь к файлу
+   * @param width Ширина кадров
+   * @param height Высота кадров
+   * @param delay Задержка между кадрами в сотых долях секунды
+   * @param dither Способ приведения цветов к палитре
+   * @throws std::invalid_argument Если размер кадра не положителен или
+   * больше `kMaxSize`
+   * @throws std::runtime_error Если файл не удаётся открыть
+   */
+  GifEncoder(const std::string &path, int width, int height, int delay,
+             GifDither dither = GifDither::kNone);
+
+  /**
+   * @brief Закрывает файл, если `Finish` не был вызван
+   */
+  ~GifEncoder();
+
+  GifEncoder(const GifEncoder &) = delete;
+  GifEncoder &operator=(const GifEncoder &) = delete;
+
+  /**
+   * @brief Добавляет кадр
+   *
+   * @param rgba Пиксели RGBA размером width * height * 4, строки сверху вниз
+   * @throws std::invalid_argument Если размер буфера не соответствует кадру
+   * @throws std::logic_error Если файл уже закрыт
+   */
+  void AddFrame(const std::vector<std::uint8_t> &rgba);
+
+  /**
+   * @brief Записывает конец файла и закрывает его
+   *
+   * Повторный вызов ничего не делает.
+   */
+  void Finish();
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;  ///< Состояние gif.h
+  int width_;                   ///< Ширина кадров
+  int height_;                  ///< Высота кадров
+  int delay_;                   ///< Задержка между кадрами
+  GifDither dither_;            ///< Способ приведения цветов к палитре
+};
+
+}  // namespace s21
+
+#endif  // IMAGE_WRITER_H_
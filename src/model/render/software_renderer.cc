@@ -0,0 +1,422 @@
+/**
+ * @file software_renderer.cc
+ * @brief Реализация класса SoftwareRenderer.
+ */
+
+#include "software_renderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "../affine_transform/transform_kernel.h"
+#include "../concurrency/thread_pool.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define S21_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+
+namespace {
+
+/// Минимальное число вершин на поток при переводе в координаты окна
+constexpr std::size_t kMinVerticesPerTask = 1 << 15;
+/// Минимальное число рёбер на поток при отсечении и раскладке по плиткам
+constexpr std::size_t kMinEdgesPerTask = 1 << 15;
+
+/// Биты кода отсечения: вершина за плоскостью пирамиды видимости
+enum Outcode : std::uint8_t {
+  kLeft = 1,
+  kRight = 2,
+  kBottom = 4,
+  kTop = 8,
+  kNear = 16,
+  kFar = 32,
+  kBehind = 64  ///< w <= 0, вершина не проецируется
+};
+
+/**
+ * Переводит вершины [begin, end) в координаты окна. Для вершин с ненулевым
+ * кодом отсечения координаты окна не используются.
+ */
+void ProjectScalar(const Mat4f& m, const float* vertices, std::size_t begin,
+                   std::size_t end, float width, float height, float* x_out,
+                   float* y_out, float* z_out, std::uint8_t* codes) {
+  for (std::size_t i = begin; i < end; ++i) {
+    float x = vertices[i * 3], y = vertices[i * 3 + 1], z = vertices[i * 3 + 2];
+    float clip[4];
+    for (int j = 0; j < 4; ++j) {
+      clip[j] = x * m(0, j) + y * m(1, j) + z * m(2, j) + m(3, j);
+    }
+    float w = clip[3];
+    codes[i] = static_cast<std::uint8_t>(
+        (clip[0] < -w ? kLeft : 0) | (clip[0] > w ? kRight : 0) |
+        (clip[1] < -w ? kBottom : 0) | (clip[1] > w ? kTop : 0) |
+        (clip[2] < -w ? kNear : 0) | (clip[2] > w ? kFar : 0) |
+        (w <= 0 ? kBehind : 0));
+    float inverse = 1.0f / w;
+    x_out[i] = (clip[0] * inverse + 1.0f) * (width * 0.5f);
+    y_out[i] = (1.0f - clip[1] * inverse) * (height * 0.5f);
+    z_out[i] = clip[2] * inverse * 0.5f + 0.5f;
+  }
+}
+
+#ifdef S21_X86_KERNELS
+
+// Обрабатывает по четыре вершины за шаг и возвращает номер первой
+// необработанной вершины; остаток дописывает скалярная реализация.
+__attribute__((target("sse2"))) std::size_t ProjectSse2(
+    const Mat4f& m, const float* vertices, std::size_t begin, std::size_t end,
+    float width, float height, float* x_out, float* y_out, float* z_out,
+    std::uint8_t* codes) {
+  __m128 c[4][4];
+  for (int j = 0; j < 4; ++j) {
+    for (int r = 0; r < 4; ++r) c[j][r] = _mm_set1_ps(m(r, j));
+  }
+  const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 half_width = _mm_set1_ps(width * 0.5f);
+  const __m128 half_height = _mm_set1_ps(height * 0.5f);
+  std::size_t i = begin;
+  for (; i + 4 <= end; i += 4) {
+    const float* p = vertices + i * 3;
+    __m128 x = _mm_set_ps(p[9], p[6], p[3], p[0]);
+    __m128 y = _mm_set_ps(p[10], p[7], p[4], p[1]);
+    __m128 z = _mm_set_ps(p[11], p[8], p[5], p[2]);
+    __m128 clip[4];
+    for (int j = 0; j < 4; ++j) {
+      clip[j] = _mm_add_ps(
+          _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, c[j][0]), _mm_mul_ps(y, c[j][1])),
+                     _mm_mul_ps(z, c[j][2])),
+          c[j][3]);
+    }
+    __m128 w = clip[3], negative_w = _mm_sub_ps(zero, w);
+    const int masks[7] = {_mm_movemask_ps(_mm_cmplt_ps(clip[0], negative_w)),
+                          _mm_movemask_ps(_mm_cmpgt_ps(clip[0], w)),
+                          _mm_movemask_ps(_mm_cmplt_ps(clip[1], negative_w)),
+                          _mm_movemask_ps(_mm_cmpgt_ps(clip[1], w)),
+                          _mm_movemask_ps(_mm_cmplt_ps(clip[2], negative_w)),
+                          _mm_movemask_ps(_mm_cmpgt_ps(clip[2], w)),
+                          _mm_movemask_ps(_mm_cmple_ps(w, zero))};
+    for (int lane = 0; lane < 4; ++lane) {
+      int code = 0;
+      for (int bit = 0; bit < 7; ++bit) {
+        code |= ((masks[bit] >> lane) & 1) << bit;
+      }
+      codes[i + lane] = static_cast<std::uint8_t>(code);
+    }
+    __m128 inverse = _mm_div_ps(one, w);
+    _mm_storeu_ps(x_out + i,
+                  _mm_mul_ps(_mm_add_ps(_mm_mul_ps(clip[0], inverse), one),
+                             half_width));
+    _mm_storeu_ps(y_out + i,
+                  _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(clip[1], inverse)),
+                             half_height));
+    _mm_storeu_ps(z_out + i,
+                  _mm_add_ps(_mm_mul_ps(_mm_mul_ps(clip[2], inverse), half),
+                             half));
+  }
+  return i;
+}
+
+#endif  // S21_X86_KERNELS
+
+/**
+ * Отсекает отрезок [a, b] в однородных координатах по шести плоскостям
+ * пирамиды видимости (алгоритм Лианга-Барски). Возвращает false, если от
+ * отрезка ничего не осталось.
+ */
+bool ClipSegment(Vec4f& a, Vec4f& b) {
+  const float a_distance[6] = {a.w + a.x, a.w - a.x, a.w + a.y,
+                               a.w - a.y, a.w + a.z, a.w - a.z};
+  const float b_distance[6] = {b.w + b.x, b.w - b.x, b.w + b.y,
+                               b.w - b.y, b.w + b.z, b.w - b.z};
+  float t_begin = 0.0f, t_end = 1.0f;
+  for (int plane = 0; plane < 6; ++plane) {
+    float da = a_distance[plane], db = b_distance[plane];
+    if (da < 0 && db < 0) return false;
+    if (da < 0) t_begin = std::max(t_begin, da / (da - db));
+    if (db < 0) t_end = std::min(t_end, da / (da - db));
+  }
+  if (t_begin > t_end) return false;
+  auto lerp = [](const Vec4f& p, const Vec4f& q, float t) {
+    return Vec4f{p.x + (q.x - p.x) * t, p.y + (q.y - p.y) * t,
+                 p.z + (q.z - p.z) * t, p.w + (q.w - p.w) * t};
+  };
+  Vec4f begin = lerp(a, b, t_begin), end = lerp(a, b, t_end);
+  a = begin;
+  b = end;
+  return a.w > 0 && b.w > 0;
+}
+
+}  // namespace
+
+Mat4f SoftwareRenderer::ViewProjection(int width, int height, bool parallel) {
+  Mat4f result = Mat4f::Identity();
+  if (parallel) {
+    // glOrtho(-1, 1, -1, 1, -10, 10)
+    result(2, 2) = -0.1f;
+    return result;
+  }
+  // glFrustum с углом обзора 60 градусов, затем glTranslatef(0, 0, -2).
+  const float near_plane = 0.1f, far_plane = 100.0f;
+  float aspect = static_cast<float>(width) / height;
+  float top = near_plane * std::tan(60.0f * static_cast<float>(M_PI) / 360.0f);
+  float right = top * aspect;
+  Mat4f frustum;
+  frustum(0, 0) = near_plane / right;
+  frustum(1, 1) = near_plane / top;
+  frustum(2, 2) = -(far_plane + near_plane) / (far_plane - near_plane);
+  frustum(2, 3) = -1.0f;
+  frustum(3, 2) = -2.0f * far_plane * near_plane / (far_plane - near_plane);
+  result(3, 2) = -2.0f;
+  return result * frustum;
+}
+
+void SoftwareRenderer::Render(int width, int height,
+                              const std::vector<float>& vertices,
+                              const IndexBuffer& faces,
+                              const std::array<float, 16>& model_matrix,
+                              const RenderSettings& settings) {
+  if (width <= 0 || height <= 0) {
+    throw std::invalid_argument("Frame size must be positive");
+  }
+  width_ = width;
+  height_ = height;
+  tiles_x_ = (width + kTileSize - 1) / kTileSize;
+  tiles_y_ = (height + kTileSize - 1) / kTileSize;
+  settings_ = settings;
+  std::size_t pixels = static_cast<std::size_t>(width) * height;
+  color_.resize(pixels * 4);
+  depth_.resize(pixels);
+
+  std::size_t vertex_count = vertices.size() / 3;
+  screen_x_.resize(vertex_count);
+  screen_y_.resize(vertex_count);
+  screen_z_.resize(vertex_count);
+  outcodes_.resize(vertex_count);
+
+  Mat4f model;
+  for (int i = 0; i < 16; ++i) model(i / 4, i % 4) = model_matrix[i];
+  Mat4f matrix = model * ViewProjection(width, height,
+                                        settings.parallel_projection);
+  ThreadPool& pool = ThreadPool::Instance();
+  pool.ParallelFor(vertex_count, kMinVerticesPerTask,
+                   [&](std::size_t begin, std::size_t end) {
+                     ProjectVertices(matrix, vertices.data(), begin, end);
+                   });
+
+  std::size_t edge_count = faces.Size() / 2;
+  std::size_t parts = std::clamp<std::size_t>(
+      std::max(edge_count / kMinEdgesPerTask, vertex_count / kMinEdgesPerTask),
+      1, pool.Size());
+  std::size_t tiles = static_cast<std::size_t>(tiles_x_) * tiles_y_;
+  parts_.resize(parts);
+  for (Part& part : parts_) {
+    part.segments.clear();
+    part.segment_bins.resize(tiles);
+    part.point_bins.resize(tiles);
+    for (auto& bin : part.segment_bins) bin.clear();
+    for (auto& bin : part.point_bins) bin.clear();
+  }
+  faces.Visit([&](const auto& indices) {
+    pool.Run(parts, [&](std::size_t i) {
+      SetupSegments(matrix, vertices.data(), indices.data(),
+                    edge_count * i / parts, edge_count * (i + 1) / parts,
+                    parts_[i]);
+      BinPoints(vertex_count * i / parts, vertex_count * (i + 1) / parts,
+                parts_[i]);
+    });
+  });
+
+  pool.Run(tiles, [this](std::size_t tile) { DrawTile(tile); });
+}
+
+void SoftwareRenderer::ProjectVertices(const Mat4f& matrix,
+                                       const float* vertices,
+                                       std::size_t begin, std::size_t end) {
+  float width = static_cast<float>(width_);
+  float height = static_cast<float>(height_);
+#ifdef S21_X86_KERNELS
+  static const bool has_sse2 =
+      TransformKernel::DetectLevel() != SimdLevel::kScalar;
+  if (has_sse2) {
+    begin = ProjectSse2(matrix, vertices, begin, end, width, height,
+                        screen_x_.data(), screen_y_.data(), screen_z_.data(),
+                        outcodes_.data());
+  }
+#endif
+  ProjectScalar(matrix, vertices, begin, end, width, height, screen_x_.data(),
+                screen_y_.data(), screen_z_.data(), outcodes_.data());
+}
+
+template <typename Index>
+void SoftwareRenderer::SetupSegments(const Mat4f& matrix,
+                                     const float* vertices,
+                                     const Index* indices, std::size_t begin,
+                                     std::size_t end, Part& part) {
+  const std::size_t vertex_count = outcodes_.size();
+  const float reach = std::max(settings_.edges_size, 1) * 0.5f + 1.0f;
+  auto clip_of = [&](std::size_t vertex) {
+    const float* p = vertices + vertex * 3;
+    return Vec4f{p[0], p[1], p[2], 1.0f} * matrix;
+  };
+  for (std::size_t edge = begin; edge < end; ++edge) {
+    std::size_t a = indices[edge * 2], b = indices[edge * 2 + 1];
+    if (a >= vertex_count || b >= vertex_count) {
+      throw std::invalid_argument("Edge index is out of range");
+    }
+    std::uint8_t code_a = outcodes_[a], code_b = outcodes_[b];
+    if (code_a & code_b) continue;
+    Segment segment;
+    if ((code_a | code_b) == 0) {
+      segment = {screen_x_[a], screen_y_[a], screen_z_[a],
+                 screen_x_[b], screen_y_[b], screen_z_[b]};
+    } else {
+      Vec4f clip_a = clip_of(a), clip_b = clip_of(b);
+      if (!ClipSegment(clip_a, clip_b)) continue;
+      auto screen = [this](const Vec4f& p, float& x, float& y, float& z) {
+        float inverse = 1.0f / p.w;
+        x = (p.x * inverse + 1.0f) * (width_ * 0.5f);
+        y = (1.0f - p.y * inverse) * (height_ * 0.5f);
+        z = p.z * inverse * 0.5f + 0.5f;
+      };
+      screen(clip_a, segment.x0, segment.y0, segment.z0);
+      screen(clip_b, segment.x1, segment.y1, segment.z1);
+    }
+    auto index = static_cast<std::uint32_t>(part.segments.size());
+    part.segments.push_back(segment);
+    AddToBins(part.segment_bins, index,
+              std::min(segment.x0, segment.x1) - reach,
+              std::min(segment.y0, segment.y1) - reach,
+              std::max(segment.x0, segment.x1) + reach,
+              std::max(segment.y0, segment.y1) + reach);
+  }
+}
+
+void SoftwareRenderer::BinPoints(std::size_t begin, std::size_t end,
+                                 Part& part) {
+  if (settings_.vertex_shape == PointShape::kNone) return;
+  const float reach = std::max(settings_.vertex_size, 1) * 0.5f + 1.0f;
+  for (std::size_t vertex = begin; vertex < end; ++vertex) {
+    if (outcodes_[vertex]) continue;
+    float x = screen_x_[vertex], y = screen_y_[vertex];
+    AddToBins(part.point_bins, static_cast<std::uint32_t>(vertex), x - reach,
+              y - reach, x + reach, y + reach);
+  }
+}
+
+void SoftwareRenderer::AddToBins(std::vector<std::vector<std::uint32_t>>& bins,
+                                 std::uint32_t index, float x0, float y0,
+                                 float x1, float y1) const {
+  if (x1 < 0 || y1 < 0 || x0 >= width_ || y0 >= height_) return;
+  int first_x = std::max(static_cast<int>(x0) / kTileSize, 0);
+  int first_y = std::max(static_cast<int>(y0) / kTileSize, 0);
+  int last_x = std::min(static_cast<int>(x1) / kTileSize, tiles_x_ - 1);
+  int last_y = std::min(static_cast<int>(y1) / kTileSize, tiles_y_ - 1);
+  for (int ty = first_y; ty <= last_y; ++ty) {
+    for (int tx = first_x; tx <= last_x; ++tx) {
+      bins[static_cast<std::size_t>(ty) * tiles_x_ + tx].push_back(index);
+    }
+  }
+}
+
+void SoftwareRenderer::DrawTile(std::size_t tile) {
+  int x_begin = static_cast<int>(tile % tiles_x_) * kTileSize;
+  int y_begin = static_cast<int>(tile / tiles_x_) * kTileSize;
+  int x_end = std::min(x_begin + kTileSize, width_);
+  int y_end = std::min(y_begin + kTileSize, height_);
+  const Rgba& background = settings_.background;
+  for (int y = y_begin; y < y_end; ++y) {
+    std::size_t row = static_cast<std::size_t>(y) * width_;
+    std::fill(depth_.begin() + row + x_begin, depth_.begin() + row + x_end,
+              1.0f);
+    for (int x = x_begin; x < x_end; ++x) {
+      std::uint8_t* pixel = &color_[(row + x) * 4];
+      pixel[0] = background.r;
+      pixel[1] = background.g;
+      pixel[2] = background.b;
+      pixel[3] = background.a;
+    }
+  }
+  for (const Part& part : parts_) {
+    for (std::uint32_t index : part.segment_bins[tile]) {
+      DrawSegment(part.segments[index], x_begin, y_begin, x_end, y_end);
+    }
+  }
+  for (const Part& part : parts_) {
+    for (std::uint32_t vertex : part.point_bins[tile]) {
+      DrawPoint(vertex, x_begin, y_begin, x_end, y_end);
+    }
+  }
+}
+
+void SoftwareRenderer::DrawSegment(const Segment& segment, int x_begin,
+                                   int y_begin, int x_end, int y_end) {
+  // Как и в OpenGL, по главной оси закрашиваются пиксели, центры которых
+  // лежат в [начало, конец), а поперёк - столбец из edges_size пикселей.
+  const int thickness = std::max(settings_.edges_size, 1);
+  const int before = (thickness - 1) / 2;
+  const bool dashed = settings_.dashed_edges;
+  const Rgba& color = settings_.edges_color;
+  float dx = segment.x1 - segment.x0, dy = segment.y1 - segment.y0;
+  float dz = segment.z1 - segment.z0;
+  bool x_major = std::fabs(dx) >= std::fabs(dy);
+  float major_origin = x_major ? segment.x0 : segment.y0;
+  float minor_origin = x_major ? segment.y0 : segment.x0;
+  float major_delta = x_major ? dx : dy;
+  if (major_delta == 0) return;
+  float minor_slope = (x_major ? dy : dx) / major_delta;
+  float z_slope = dz / major_delta;
+  float low = std::min(major_origin, major_origin + major_delta);
+  float high = std::max(major_origin, major_origin + major_delta);
+  int major_begin = x_major ? x_begin : y_begin;
+  int major_end = x_major ? x_end : y_end;
+  int minor_begin = x_major ? y_begin : x_begin;
+  int minor_end = x_major ? y_end : x_end;
+  int first = std::max(static_cast<int>(std::ceil(low - 0.5f)), major_begin);
+  int last = std::min(static_cast<int>(std::ceil(high - 0.5f)), major_end);
+  for (int major = first; major < last; ++major) {
+    float offset = major + 0.5f - major_origin;
+    // glLineStipple(1, 0x00FF): 8 пикселей от первой вершины рисуются,
+    // следующие 8 пропускаются.
+    if (dashed && (static_cast<int>(std::fabs(offset)) & 15) >= 8) continue;
+    float minor_center = minor_origin + offset * minor_slope;
+    float z = segment.z0 + offset * z_slope;
+    int minor_first = static_cast<int>(std::floor(minor_center)) - before;
+    int from = std::max(minor_first, minor_begin);
+    int to = std::min(minor_first + thickness, minor_end);
+    for (int minor = from; minor < to; ++minor) {
+      if (x_major) {
+        Plot(major, minor, z, color);
+      } else {
+        Plot(minor, major, z, color);
+      }
+    }
+  }
+}
+
+void SoftwareRenderer::DrawPoint(std::size_t vertex, int x_begin, int y_begin,
+                                 int x_end, int y_end) {
+  const int size = std::max(settings_.vertex_size, 1);
+  const float radius = size * 0.5f;
+  const bool round = settings_.vertex_shape == PointShape::kRound;
+  float x = screen_x_[vertex], y = screen_y_[vertex], z = screen_z_[vertex];
+  int left = static_cast<int>(std::floor(x - radius + 0.5f));
+  int top = static_cast<int>(std::floor(y - radius + 0.5f));
+  int x_from = std::max(left, x_begin), x_to = std::min(left + size, x_end);
+  int y_from = std::max(top, y_begin), y_to = std::min(top + size, y_end);
+  for (int row = y_from; row < y_to; ++row) {
+    for (int column = x_from; column < x_to; ++column) {
+      if (round) {
+        float cx = column + 0.5f - x, cy = row + 0.5f - y;
+        if (cx * cx + cy * cy > radius * radius) continue;
+      }
+      Plot(column, row, z, settings_.vertex_color);
+    }
+  }
+}
+
+}  // namespace s21
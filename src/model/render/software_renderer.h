@@ -0,0 +1,249 @@
+/**
+ * @file software_renderer.h
+ * @brief Заголовочный файл для программной отрисовки каркаса модели.
+ *
+ * `SoftwareRenderer` строит на процессоре то же изображение, что и
+ * `ModelRender::paintGL`: параллельную или центральную проекцию, рёбра
+ * заданной толщины с тестом глубины и пунктиром `glLineStipple(1, 0x00FF)`,
+ * квадратные или круглые точки. Видеокарта и оконная система не нужны,
+ * поэтому отрисовка работает на серверах без дисплея.
+ *
+ * Отрисовка идёт в три прохода, каждый из которых распределяется по
+ * `ThreadPool`:
+ * - вершины переводятся в координаты окна и получают коды отсечения (на x86
+ *   по четыре вершины за шаг SSE2);
+ * - рёбра отсекаются по пирамиде видимости и раскладываются по плиткам
+ *   `kTileSize` x `kTileSize` пикселей, которые они могут задеть;
+ * - плитки растеризуются независимо, каждая своим потоком. Рёбра и точки
+ *   внутри плитки рисуются в порядке буфера индексов, поэтому результат не
+ *   зависит от числа потоков.
+ *
+ * Результат - буфер RGBA по 8 бит на канал, строки сверху вниз.
+ */
+
+#ifndef SOFTWARE_RENDERER_H_
+#define SOFTWARE_RENDERER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../affine_transform/mat4.h"
+#include "../parser/index_buffer.h"
+
+namespace s21 {
+
+/**
+ * Цвет RGBA по 8 бит на канал
+ */
+
+struct Rgba {
+  std::uint8_t r = 0;    ///< Красный
+  std::uint8_t g = 0;    ///< Зелёный
+  std::uint8_t b = 0;    ///< Синий
+  std::uint8_t a = 255;  ///< Непрозрачность
+};
+
+/**
+ * Форма вершин; значения совпадают с `Settings::vertex_shape`
+ */
+enum class PointShape {
+  kNone = 0,   ///< Вершины не рисуются
+  kRound = 1,  ///< Круг
+  kSquare = 2  ///< Квадрат
+};
+
+/**
+ * Параметры отрисовки, соответствующие настройкам `ModelRender`
+ */
+
+struct RenderSettings {
+  Rgba background{0, 0, 0, 255};          ///< Цвет фона
+  Rgba edges_color{255, 255, 255, 255};   ///< Цвет рёбер
+  Rgba vertex_color{255, 255, 255, 255};  ///< Цвет вершин
+  int edges_size = 1;                     ///< Толщина рёбер в пикселях
+  bool dashed_edges = false;              ///< Пунктир 8 пикселей через 8
+  int vertex_size = 5;                    ///< Размер вершин в пикселях
+  PointShape vertex_shape = PointShape::kRound;  ///< Форма вершин
+  bool parallel_projection = true;  ///< Параллельная или центральная проекция
+};
+
+/**
+ * @class SoftwareRenderer
+ * @brief Многопоточная программная отрисовка рёбер и вершин модели.
+ *
+ * Объект хранит буферы кадра и промежуточные массивы между вызовами
+ * `Render`, поэтому серия кадров одного размера не выделяет память заново.
+ */
+class SoftwareRenderer {
+ public:
+  /// Сторона плитки, растеризуемой одним потоком
+  static constexpr int kTileSize = 64;
+
+  /**
+   * @brief Рисует кадр
+   *
+   * @param width Ширина кадра в пикселях
+   * @param height Высота кадра в пикселях
+   * @param vertices Вершины x, y, z
+   * @param faces Пары индексов вершин рёбер
+   * @param model_matrix Матрица модели в порядке OpenGL (по столбцам)
+   * @param settings Параметры отрисовки
+   * @throws std::invalid_argument Если размер кадра не положителен или
+   * индекс ребра выходит за пределы вершин
+   */
+  void Render(int width, int height, const std::vector<float> &vertices,
+              const IndexBuffer &faces,
+              const std::array<float, 16> &model_matrix,
+              const RenderSettings &settings);
+
+  /**
+   * @brief Возвращает ширину последнего кадра
+   * @return Ширина в пикселях
+   */
+  int Width() const { return width_; }
+
+  /**
+   * @brief Возвращает высоту последнего кадра
+   * @return Высота в пикселях
+   */
+  int Height() const { return height_; }
+
+  /**
+   * @brief Возвращает пиксели последнего кадра
+   * @return Буфер RGBA размером Width() * Height() * 4, строки сверху вниз
+   */
+  const std::vector<std::uint8_t> &Pixels() const { return color_; }
+
+  /**
+   * @brief Возвращает матрицу вида и проекции `ModelRender::paintGL`
+   *
+   * Матрица записана для векторов-строк, как и матрицы `AffineTransform`.
+   *
+   * @param width Ширина кадра
+   * @param height Высота кадра
+   * @param parallel Параллельная проекция
+   * @return Произведение матрицы вида на матрицу проекции
+   */
+  static Mat4f ViewProjection(int width, int height, bool parallel);
+
+ private:
+  /**
+   * Ребро в координатах окна. Первая вершина - начало отсчёта пунктира.
+   */
+  struct Segment {
+    float x0, y0, z0;  ///< Первая вершина
+    float x1, y1, z1;  ///< Вторая вершина
+  };
+
+  /**
+   * Рёбра и вершины части буфера индексов, разложенные по плиткам
+   */
+  struct Part {
+    std::vector<Segment> segments{};  ///< Отсечённые рёбра части
+    std::vector<std::vector<std::uint32_t>> segment_bins{};  ///< Номера
+                                                             ///< рёбер
+    std::vector<std::vector<std::uint32_t>> point_bins{};    ///< Номера
+                                                             ///< вершин
+  };
+
+  /**
+   * @brief Переводит вершины в координаты окна
+   *
+   * @param matrix Матрица модели, вида и проекции
+   * @param vertices Вершины x, y, z
+   * @param begin Первая вершина
+   * @param end Вершина за последней
+   */
+  void ProjectVertices(const Mat4f &matrix, const float *vertices,
+                       std::size_t begin, std::size_t end);
+
+  /**
+   * @brief Отсекает рёбра части буфера индексов и раскладывает их по плиткам
+   *
+   * @param matrix Матрица модели, вида и проекции
+   * @param vertices Вершины x, y, z
+   * @param indices Индексы рёбер в собственном типе буфера
+   * @param begin Первое ребро
+   * @param end Ребро за последним
+   * @param part Часть, в которую записываются рёбра
+   */
+  template <typename Index>
+  void SetupSegments(const Mat4f &matrix, const float *vertices,
+                     const Index *indices, std::size_t begin,
+                     std::size_t end, Part &part);
+
+  /**
+   * @brief Раскладывает видимые вершины части по плиткам
+   *
+   * @param begin Первая вершина
+   * @param end Вершина за последней
+   * @param part Часть, в которую записываются вершины
+   */
+  void BinPoints(std::size_t begin, std::size_t end, Part &part);
+
+  /**
+   * @brief Добавляет номер в списки плиток, которые задевает прямоугольник
+   *
+   * @param bins Списки плиток
+   * @param index Номер ребра или вершины
+   * @param x0 Левая граница
+   * @param y0 Верхняя граница
+   * @param x1 Правая граница
+   * @param y1 Нижняя граница
+   */
+  void AddToBins(std::vector<std::vector<std::uint32_t>> &bins,
+                 std::uint32_t index, float x0, float y0, float x1,
+                 float y1) const;
+
+  /**
+   * @brief Растеризует одну плитку
+   * @param tile Номер плитки
+   */
+  void DrawTile(std::size_t tile);
+
+  /**
+   * @brief Рисует часть ребра, попадающую в прямоугольник плитки
+   */
+  void DrawSegment(const Segment &segment, int x_begin, int y_begin,
+                   int x_end, int y_end);
+
+  /**
+   * @brief Рисует часть вершины, попадающую в прямоугольник плитки
+   */
+  void DrawPoint(std::size_t vertex, int x_begin, int y_begin, int x_end,
+                 int y_end);
+
+  /**
+   * @brief Записывает пиксель, если он ближе записанного ранее
+   */
+  void Plot(int x, int y, float z, const Rgba &color) {
+    std::size_t index = static_cast<std::size_t>(y) * width_ + x;
+    if (z < depth_[index]) {
+      depth_[index] = z;
+      std::uint8_t *pixel = &color_[index * 4];
+      pixel[0] = color.r;
+      pixel[1] = color.g;
+      pixel[2] = color.b;
+      pixel[3] = color.a;
+    }
+  }
+
+  int width_ = 0;                        ///< Ширина кадра
+  int height_ = 0;                       ///< Высота кадра
+  int tiles_x_ = 0;                      ///< Число плиток по горизонтали
+  int tiles_y_ = 0;                      ///< Число плиток по вертикали
+  RenderSettings settings_{};            ///< Параметры текущего кадра
+  std::vector<std::uint8_t> color_{};    ///< Пиксели RGBA
+  std::vector<float> depth_{};           ///< Глубина пикселей
+  std::vector<float> screen_x_{};        ///< X вершин в окне
+  std::vector<float> screen_y_{};        ///< Y вершин в окне (вниз)
+  std::vector<float> screen_z_{};        ///< Глубина вершин в [0, 1]
+  std::vector<std::uint8_t> outcodes_{};  ///< Коды отсечения вершин
+  std::vector<Part> parts_{};             ///< Части буфера индексов
+};
+
+}  // namespace s21
+
+#endif  // SOFTWARE_RENDERER_H_
@@ -5,8 +5,97 @@
 #include <random>
 
 #include "../model/affine_transform/affinetransform.h"
+#include "../model/affine_transform/transform_kernel.h"
 using namespace s21;
 
+TEST(Mat4Test, ConstexprProduct) {
+  constexpr Mat4 identity = Mat4::Identity();
+  static_assert(identity.IsIdentity(), "Identity() must be identity");
+  static_assert((identity * identity).IsIdentity(), "I * I must be I");
+
+  Mat4 move = Mat4::Identity(), scale = Mat4::Identity();
+  move(3, 0) = 1;
+  move(3, 1) = 2;
+  move(3, 2) = 3;
+  scale[0][0] = scale[1][1] = scale[2][2] = 2;
+  Vec4 vertex = Vec4{1, 1, 1, 1} * (scale * move);
+  EXPECT_DOUBLE_EQ(vertex.x, 3);
+  EXPECT_DOUBLE_EQ(vertex.y, 4);
+  EXPECT_DOUBLE_EQ(vertex.z, 5);
+  EXPECT_DOUBLE_EQ(vertex.w, 1);
+  EXPECT_FALSE((move * scale) == (scale * move));
+}
+
+TEST(Mat4Test, AffineInverse) {
+  GeneralTransformMatrix matrix;
+  matrix.SetTransformMatrix({{1.5f, 0.5f, 2}, {3, -4, 5}, {0.3f, -1.2f, 2.5f}});
+  Mat4 product = matrix.GetMatrix() * matrix.GetMatrix().AffineInverse();
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      ASSERT_NEAR(product(i, j), i == j ? 1 : 0, 1e-12);
+    }
+  }
+  constexpr Mat4 identity = Mat4::Identity().AffineInverse();
+  static_assert(identity.IsIdentity(), "Inverse of I must be I");
+}
+
+TEST(TransformKernelTest, SimdMatchesScalar) {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<float> dis(-1000.0f, 1000.0f);
+  std::vector<float> source(1003 * 3);
+  for (float &value : source) value = dis(gen);
+  TransformParametrs delta = {{1.5f, 0.5f, 2}, {3, -4, 5}, {0.3f, -1.2f, 2.5f}};
+  GeneralTransformMatrix matrix;
+  matrix.SetTransformMatrix(delta);
+
+  std::vector<float> expected(source.size());
+  TransformKernel::Transform(matrix.GetMatrix(), source.data(),
+                             expected.data(), 1003, SimdLevel::kScalar);
+  for (auto level : {SimdLevel::kSse2, SimdLevel::kAvx2, SimdLevel::kAvx512}) {
+    for (size_t count : {0, 3, 4, 9, 1003}) {
+      std::vector<float> actual(source.begin(), source.begin() + count * 3);
+      TransformKernel::Transform(matrix.GetMatrix(), actual.data(),
+                                 actual.data(), count, level);
+      for (size_t i = 0; i < count * 3; ++i) {
+        ASSERT_EQ(actual[i], expected[i]) << "level " << int(level);
+      }
+    }
+  }
+}
+
+TEST(TransformKernelTest, ShapedMatchesGeneral) {
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<float> dis(-1000.0f, 1000.0f);
+  std::vector<float> source(1003 * 3);
+  for (float &value : source) value = dis(gen);
+  struct ShapeCase {
+    TransformParametrs delta;
+    TransformShape shape;
+  };
+  const ShapeCase cases[] = {
+      {{{0, 0, 0}, {0.5f, -3, 7.25f}, {0, 0, 0}}, TransformShape::kTranslate},
+      {{{1.1f, 1.1f, 1.1f}, {0, 0, 0}, {0, 0, 0}}, TransformShape::kScale},
+      {{{0, 0, 0}, {0, 0, 0}, {0.7f, 0, 0}}, TransformShape::kRotateX},
+      {{{0, 0, 0}, {0, 0, 0}, {0, -0.4f, 0}}, TransformShape::kRotateY},
+      {{{0, 0, 0}, {0, 0, 0}, {0, 0, 2.1f}}, TransformShape::kRotateZ},
+  };
+  for (const ShapeCase &shape : cases) {
+    GeneralTransformMatrix matrix;
+    matrix.SetTransformMatrix(shape.delta);
+    std::vector<float> expected(source.size());
+    TransformKernel::Transform(matrix.GetMatrix(), source.data(),
+                               expected.data(), 1003, SimdLevel::kScalar);
+    for (size_t count : {0, 5, 8, 1003}) {
+      std::vector<float> actual(source.begin(), source.begin() + count * 3);
+      TransformKernel::Transform(matrix.GetMatrix(), actual.data(),
+                                 actual.data(), count, shape.shape);
+      for (size_t i = 0; i < count * 3; ++i) {
+        ASSERT_EQ(actual[i], expected[i]) << "shape " << int(shape.shape);
+      }
+    }
+  }
+}
+
 TEST(MatrixBuilderTest, CreateIdentityMatrix) {
   MatrixBuilder *creator = new GeneralMatrixBuilder();
   TransformMatrix *g_matrix = creator->FactoryMethod();
@@ -24,6 +113,19 @@ TEST(MatrixBuilderTest, CreateIdentityMatrix) {
   delete creator;
 }
 
+TEST(MatrixBuilderTest, StaticBuildMatchesFactory) {
+  TransformParametrs delta = {{1.5f, 2, 0.5f}, {3, -4, 5}, {0.3f, -1.2f, 2.5f}};
+  MatrixBuilder *creator = new GeneralMatrixBuilder();
+  TransformMatrix *g_matrix = creator->FactoryMethod();
+  g_matrix->SetTransformMatrix(delta);
+
+  GeneralTransformMatrix built = GeneralMatrixBuilder::Build(delta);
+  ASSERT_TRUE(built.GetMatrix() == g_matrix->GetMatrix());
+  ASSERT_TRUE(RotationMatrixBuilder::Build({}).IsIdentityMatrix());
+  delete g_matrix;
+  delete creator;
+}
+
 TEST(MatrixBuilderTest, CreateScaleMatrix4x4) {
   TransformParametrs delta = {{2, 2, 2}, {0, 0, 0}, {0, 0, 0}};
   MatrixBuilder *creator = new GeneralMatrixBuilder();
@@ -283,6 +385,33 @@ TEST(AffineTransformTest, ValuesOfVertices_Rotation) {
   ASSERT_NEAR(vertices[2], -0.36602, 1e-3);
 }
 
+TEST(AffineTransformTest, FusedLocalTransform) {
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+  std::vector<float> vertices(999);
+  for (float &value : vertices) value = dis(gen);
+  std::vector<float> expected = vertices;
+
+  TransformParametrs move = {{0, 0, 0}, {0.5f, -2, 3}, {0, 0, 0}};
+  TransformParametrs rotate = {{1.5f, 1.5f, 1.5f}, {0, 0, 0}, {0.2f, 0, 0.7f}};
+  AffineTransform aff_tr;
+  aff_tr.AddVertices(&vertices);
+  aff_tr.TransformVertices(move);
+  aff_tr.TransformVertices(rotate);
+
+  // Прежний порядок: три прохода T(-t), M, T(t) после начального сдвига.
+  TransformParametrs to_local = {{0, 0, 0}, {-0.5f, 2, -3}, {0, 0, 0}};
+  const TransformParametrs steps[] = {move, to_local, rotate, move};
+  for (const TransformParametrs &step : steps) {
+    GeneralTransformMatrix matrix = GeneralMatrixBuilder::Build(step);
+    TransformKernel::Transform(matrix.GetMatrix(), expected.data(),
+                               expected.data(), expected.size() / 3);
+  }
+  for (size_t i = 0; i < vertices.size(); i++) {
+    ASSERT_NEAR(vertices[i], expected[i], 1e-5);
+  }
+}
+
 TEST(AffineTransformTest, LocalMove) {
   std::vector<float> vertices = {-1, 1, 0, 1, 1, 0, 1, -1, 0, -1, -1, 0};
 
@@ -297,4 +426,4 @@ TEST(AffineTransformTest, LocalMove) {
   for (size_t i = 0; i < vertices.size(); i++) {
     ASSERT_NEAR(vertices[i], expected[i], 1e-3);
   }
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include "../model/render/batch_renderer.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace s21;
+
+namespace {
+
+std::string ReadBytes(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), {});
+}
+
+}  // namespace
+
+TEST(BatchTest, ParseArgumentsBuildsViews) {
+  BatchOptions options = BatchRenderer::ParseArguments(
+      {"-o", "out", "--size", "320x200", "--edges-color", "#ff8000", "a.obj",
+       "--view", "front", "--view", "spin", "--format", "gif", "--rotate",
+       "0,-90,0", "--frames", "12", "--dither", "ordered", "b.obj"});
+  EXPECT_EQ(options.output_dir, "out");
+  EXPECT_EQ(options.inputs, (std::vector<std::string>{"a.obj", "b.obj"}));
+  ASSERT_EQ(options.views.size(), 2u);
+  EXPECT_EQ(options.views[0].name, "front");
+  EXPECT_EQ(options.views[0].format, ImageFormat::kPng);
+  EXPECT_EQ(options.views[1].format, ImageFormat::kGif);
+  EXPECT_EQ(options.views[1].frames, 12);
+  EXPECT_FLOAT_EQ(options.views[1].rotation.y, -90);
+  EXPECT_EQ(options.views[0].dither, GifDither::kNone);
+  EXPECT_EQ(options.views[1].dither, GifDither::kOrdered);
+  for (const BatchView &view : options.views) {
+    EXPECT_EQ(view.width, 320);
+    EXPECT_EQ(view.height, 200);
+    EXPECT_EQ(view.settings.edges_color.g, 0x80);
+  }
+
+  options = BatchRenderer::ParseArguments({"a.obj"});
+  ASSERT_EQ(options.views.size(), 1u);
+  EXPECT_TRUE(options.views[0].name.empty());
+  EXPECT_TRUE(BatchRenderer::ParseArguments({"--help"}).help);
+
+  EXPECT_THROW(BatchRenderer::ParseArguments({}), std::invalid_argument);
+  EXPECT_THROW(BatchRenderer::ParseArguments({"--size", "10", "a.obj"}),
+               std::invalid_argument);
+  EXPECT_THROW(BatchRenderer::ParseArguments({"--scale", "0", "a.obj"}),
+               std::invalid_argument);
+  EXPECT_THROW(BatchRenderer::ParseArguments({"--unknown", "1", "a.obj"}),
+               std::invalid_argument);
+  EXPECT_THROW(BatchRenderer::ParseArguments({"--dither", "x", "a.obj"}),
+               std::invalid_argument);
+  EXPECT_THROW(BatchRenderer::ParseArguments({"a.obj", "--frames"}),
+               std::invalid_argument);
+  EXPECT_THROW(
+      BatchRenderer::ParseArguments({"--view", "a", "--view", "a", "a.obj"}),
+      std::invalid_argument);
+  EXPECT_THROW(BatchRenderer::ParseArguments({"a/cube.obj", "b/cube.obj"}),
+               std::invalid_argument);
+  EXPECT_THROW(BatchRenderer::ParseArguments(
+                   {"--format", "gif", "--size", "65536x10", "a.obj"}),
+               std::invalid_argument);
+  EXPECT_NO_THROW(
+      BatchRenderer::ParseArguments({"--size", "65536x10", "a.obj"}));
+
+  BatchOptions clashing;
+  clashing.inputs = {"a/cube.obj", "b/cube.obj"};
+  EXPECT_THROW(BatchRenderer(clashing).Run(), std::invalid_argument);
+}
+
+TEST(BatchTest, RunWritesImagesAndReportsErrors) {
+  std::filesystem::path dir =
+      std::filesystem::temp_directory_path() / "s21_batch_test";
+  std::filesystem::remove_all(dir);
+  BatchOptions options = BatchRenderer::ParseArguments(
+      {"-o", dir.string(), "--size", "64x48", "--view", "still", "--view",
+       "spin", "--format", "gif", "--frames", "4", "tests/files/cube.obj",
+       "tests/files/invalid_file.obj", "tests/files/pyramid.obj"});
+  BatchRenderer renderer(options);
+  int reported = 0;
+  std::vector<BatchResult> results =
+      renderer.Run([&reported](const BatchResult &) { ++reported; });
+
+  EXPECT_EQ(reported, 3);
+  ASSERT_EQ(results.size(), 3u);
+  EXPECT_TRUE(results[0].error.empty());
+  EXPECT_FALSE(results[1].error.empty());
+  EXPECT_TRUE(results[1].outputs.empty());
+  EXPECT_TRUE(results[2].error.empty());
+  ASSERT_EQ(results[0].outputs.size(), 2u);
+  EXPECT_EQ(results[0].outputs[0], (dir / "cube_still.png").string());
+  EXPECT_EQ(results[0].outputs[1], (dir / "cube_spin.gif").string());
+
+  std::string png = ReadBytes(results[2].outputs[0]);
+  EXPECT_EQ(png.substr(0, 8), "\x89PNG\r\n\x1a\n");
+  EXPECT_EQ(png.substr(12, 4), "IHDR");
+  EXPECT_EQ(png.substr(16, 8), std::string("\0\0\0\x40\0\0\0\x30", 8));
+  EXPECT_EQ(png.substr(png.size() - 8, 4), "IEND");
+  std::string gif = ReadBytes(results[2].outputs[1]);
+  EXPECT_EQ(gif.substr(0, 6), "GIF89a");
+  EXPECT_EQ(gif.back(), '\x3b');
+  std::filesystem::remove_all(dir);
+}
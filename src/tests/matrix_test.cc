@@ -0,0 +1,188 @@
+#include "../libs/s21_matrix_oop.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace s21;
+
+namespace {
+
+Matrix RandomMatrix(int rows, int cols, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dis(-10.0, 10.0);
+  Matrix result(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) result(i, j) = dis(gen);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(MatrixTest, CopyAndMove) {
+  for (int size : {2, 4, 5, 40}) {
+    Matrix source = RandomMatrix(size, size + 1, size);
+    Matrix copy(source);
+    ASSERT_TRUE(copy == source);
+
+    Matrix moved(std::move(copy));
+    ASSERT_TRUE(moved == source);
+    EXPECT_EQ(copy.GetRows(), 0);
+
+    Matrix assigned(3, 3);
+    assigned = std::move(moved);
+    ASSERT_TRUE(assigned == source);
+    EXPECT_EQ(moved.GetCols(), 0);
+
+    moved = source;
+    ASSERT_TRUE(moved == source);
+    assigned = assigned;
+    ASSERT_TRUE(assigned == source);
+  }
+}
+
+TEST(MatrixTest, BlockedMulMatchesNaive) {
+  const int sizes[][3] = {{1, 1, 1}, {3, 5, 2}, {4, 4, 4}, {70, 65, 130}};
+  for (const auto &size : sizes) {
+    Matrix a = RandomMatrix(size[0], size[1], 1);
+    Matrix b = RandomMatrix(size[1], size[2], 2);
+    Matrix expected(size[0], size[2]);
+    for (int k = 0; k < size[1]; ++k) {
+      for (int i = 0; i < size[0]; ++i) {
+        for (int j = 0; j < size[2]; ++j) expected(i, j) += a(i, k) * b(k, j);
+      }
+    }
+    Matrix product = a * b;
+    for (int i = 0; i < size[0]; ++i) {
+      for (int j = 0; j < size[2]; ++j) {
+        ASSERT_EQ(product(i, j), expected(i, j));
+      }
+    }
+  }
+  Matrix a(2, 3), b(2, 3);
+  EXPECT_THROW(a.MulMatrix(b), std::range_error);
+}
+
+TEST(MatrixTest, ResizeKeepsElements) {
+  Matrix m = RandomMatrix(4, 4, 3);
+  Matrix original(m);
+  m.SetRows(6);
+  m.SetCols(5);
+  EXPECT_EQ(m.GetRows(), 6);
+  EXPECT_EQ(m.GetCols(), 5);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) ASSERT_EQ(m(i, j), original(i, j));
+  }
+  EXPECT_EQ(m(5, 4), 0);
+  m.SetCols(2);
+  m.SetRows(1);
+  EXPECT_EQ(m(0, 1), original(0, 1));
+  EXPECT_THROW(m(1, 0), std::out_of_range);
+}
+
+namespace {
+
+double MaxDeviationFromIdentity(const Matrix &m) {
+  double deviation = 0;
+  for (int i = 0; i < m.GetRows(); ++i) {
+    for (int j = 0; j < m.GetCols(); ++j) {
+      deviation = std::max(deviation, std::fabs(m(i, j) - (i == j ? 1 : 0)));
+    }
+  }
+  return deviation;
+}
+
+}  // namespace
+
+TEST(MatrixTest, DeterminantWithPivoting) {
+  Matrix swap(2, 2);
+  swap(0, 1) = swap(1, 0) = 1;
+  EXPECT_DOUBLE_EQ(swap.Determinant(), -1);
+
+  Matrix m(3, 3);
+  double values[] = {0, 2, 1, 3, -1, 4, 2, 5, -2};
+  for (int i = 0; i < 9; ++i) m(i / 3, i % 3) = values[i];
+  EXPECT_NEAR(m.Determinant(), 45, 1e-12);
+
+  Matrix singular = RandomMatrix(6, 6, 5);
+  for (int j = 0; j < 6; ++j) singular(5, j) = singular(0, j) + singular(1, j);
+  EXPECT_EQ(singular.Determinant(), 0);
+  EXPECT_THROW(singular.InverseMatrix(), std::invalid_argument);
+  EXPECT_THROW(Matrix(2, 3).Determinant(), std::range_error);
+}
+
+TEST(MatrixTest, InverseIsStable) {
+  // Без выбора ведущего элемента деление на 1e-20 уничтожает результат.
+  Matrix tiny_pivot(2, 2);
+  tiny_pivot(0, 0) = 1e-20;
+  tiny_pivot(0, 1) = tiny_pivot(1, 0) = tiny_pivot(1, 1) = 1;
+  EXPECT_LT(MaxDeviationFromIdentity(tiny_pivot * tiny_pivot.InverseMatrix()),
+            1e-15);
+
+  for (int size : {3, 10, 60, 200}) {
+    Matrix m = RandomMatrix(size, size, size);
+    EXPECT_LT(MaxDeviationFromIdentity(m * m.InverseMatrix()), 1e-9) << size;
+  }
+
+  // Малые элементы не делают матрицу вырожденной.
+  Matrix small(10, 10);
+  for (int i = 0; i < 10; ++i) small(i, i) = 1e-3;
+  EXPECT_NEAR(small.InverseMatrix()(9, 9), 1e3, 1e-9);
+
+  Matrix hilbert(8, 8);
+  for (int i = 0; i < 8; ++i) {
+    for (int j = 0; j < 8; ++j) hilbert(i, j) = 1.0 / (i + j + 1);
+  }
+  EXPECT_LT(MaxDeviationFromIdentity(hilbert * hilbert.InverseMatrix()), 1e-5);
+
+  Matrix m = RandomMatrix(5, 5, 9);
+  Matrix complements = m.CalcComplements();
+  EXPECT_NEAR(complements(2, 3), m.CreateMinor(2, 3).Determinant() * -1,
+              1e-9);
+}
+
+TEST(MatrixTest, AffineInverse4x4) {
+  Matrix affine = RandomMatrix(4, 4, 13);
+  affine(0, 3) = affine(1, 3) = affine(2, 3) = 0;
+  affine(3, 3) = 1;
+  EXPECT_LT(MaxDeviationFromIdentity(affine * affine.InverseMatrix()), 1e-12);
+
+  Matrix column_affine = affine.Transpose();
+  EXPECT_LT(MaxDeviationFromIdentity(column_affine *
+                                     column_affine.InverseMatrix()),
+            1e-12);
+
+  Matrix flat(affine);
+  for (int j = 0; j < 3; ++j) flat(2, j) = 0;
+  EXPECT_THROW(flat.InverseMatrix(), std::invalid_argument);
+}
+
+TEST(MatrixTest, InverseOfUnevenlyScaledMatrix) {
+  // Регулярные матрицы с сильно различающимся масштабом строк.
+  for (auto diagonal : std::vector<std::vector<double>>{
+           {1e8, 1e-8, 1}, {1e20, 1e-10}, {1e6, 1e-6, 1, 1}}) {
+    const int n = static_cast<int>(diagonal.size());
+    Matrix m(n, n);
+    for (int i = 0; i < n; ++i) m(i, i) = diagonal[i];
+    EXPECT_NE(m.Determinant(), 0) << n;
+    Matrix inverse = m.InverseMatrix();
+    Matrix complements = m.CalcComplements();
+    for (int i = 0; i < n; ++i) {
+      EXPECT_NEAR(inverse(i, i) * diagonal[i], 1, 1e-12) << n;
+      EXPECT_NEAR(complements(i, i) * diagonal[i], m.Determinant(), 1e-9) << n;
+    }
+  }
+
+  // Аффинная матрица с неравномерным масштабом линейной части.
+  Matrix affine(4, 4);
+  affine(0, 0) = 1e6;
+  affine(1, 1) = 1e-6;
+  affine(2, 2) = affine(3, 3) = 1;
+  affine(3, 0) = 5;
+  EXPECT_LT(MaxDeviationFromIdentity(affine * affine.InverseMatrix()), 1e-12);
+}
@@ -2,6 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <fstream>
+
+#include "../model/model_loader.h"
+#include "../model/parser/mesh_cache.h"
+
 using namespace s21;
 
 TEST(ModelTest, GetVertices) {
@@ -23,10 +29,9 @@ TEST(ModelTest, GetFaces) {
   model_.LoadFile("tests/files/cube.obj");
   const auto& faces = model_.GetFaces();
   std::vector<unsigned int> expected_faces{
-      4, 2, 2, 0, 0, 4, 2, 7, 7, 3, 3, 2, 6, 5, 5, 7, 7, 6, 1, 7, 7, 5, 5, 1,
-      0, 3, 3, 1, 1, 0, 4, 1, 1, 5, 5, 4, 4, 6, 6, 2, 2, 4, 2, 6, 6, 7, 7, 2,
-      6, 4, 4, 5, 5, 6, 1, 3, 3, 7, 7, 1, 0, 2, 2, 3, 3, 0, 4, 0, 0, 1, 1, 4};
-  EXPECT_EQ(faces.size(), expected_faces.size());
+      0, 1, 0, 2, 0, 3, 0, 4, 1, 3, 1, 4, 1, 5, 1, 7, 2, 3,
+      2, 4, 2, 6, 2, 7, 3, 7, 4, 5, 4, 6, 5, 6, 5, 7, 6, 7};
+  EXPECT_EQ(faces.Size(), expected_faces.size());
   for (size_t i = 0; i < expected_faces.size(); ++i) {
     EXPECT_EQ(faces[i], expected_faces[i]);
   }
@@ -68,9 +73,210 @@ TEST(ModelTest, Transform) {
   EXPECT_NE(vertices_after[0], 1.0f);
 }
 
+TEST(ModelTest, RetainedTransform) {
+  s21::Model baked, retained;
+  baked.LoadFile("tests/files/cube_2.obj");
+  retained.LoadFile("tests/files/cube_2.obj");
+  retained.SetTransformMode(s21::TransformMode::kRetained);
+  const std::vector<float> pristine = retained.GetVertices();
+
+  std::vector<TransformParametrs> steps{
+      {{0, 0, 0}, {0.3f, 0, 0}, {0, 0, 0}},
+      {{0, 0, 0}, {0, 0, 0}, {0.7f, 0, 0}},
+      {{2, 2, 2}, {0, 0, 0}, {0, 0, 0}},
+      {{0, 0, 0}, {0, -0.2f, 0.1f}, {0, 0.4f, -1.1f}}};
+  for (auto& step : steps) {
+    auto copy = step;
+    baked.Transform(step);
+    retained.Transform(copy);
+  }
+  EXPECT_EQ(retained.GetVertices(), pristine);
+
+  std::vector<float> transformed = retained.GetTransformedVertices();
+  ASSERT_EQ(transformed.size(), baked.GetVertices().size());
+  for (size_t i = 0; i < transformed.size(); ++i) {
+    EXPECT_NEAR(transformed[i], baked.GetVertices()[i], 1e-5);
+  }
+  float expected[6], actual[6];
+  baked.CalculateBoundingBox(expected[0], expected[1], expected[2],
+                             expected[3], expected[4], expected[5]);
+  retained.CalculateBoundingBox(actual[0], actual[1], actual[2], actual[3],
+                                actual[4], actual[5]);
+  for (int i = 0; i < 6; ++i) EXPECT_NEAR(actual[i], expected[i], 1e-5);
+
+  retained.BakeTransform();
+  EXPECT_EQ(retained.GetVertices(), transformed);
+  auto identity = retained.GetModelMatrix();
+  for (int i = 0; i < 16; ++i) EXPECT_EQ(identity[i], i % 5 == 0 ? 1.0f : 0.0f);
+}
+
+TEST(ModelTest, SharedMeshBuffers) {
+  s21::Model model;
+  model.LoadFile("tests/files/cube_2.obj");
+  MeshBuffer published = model.GetMesh();
+  const float *first = published.vertices.Get().data();
+  EXPECT_EQ(published.vertices.UseCount(), 2);
+  EXPECT_EQ(first, model.GetVertices().data());
+
+  // Опубликованные вершины не меняются, результат пишется во второй буфер.
+  std::vector<float> before = published.vertices.Get();
+  TransformParametrs delta = {{0, 0, 0}, {0.5f, 0, 0}, {0, 0, 0}};
+  model.Transform(delta);
+  EXPECT_EQ(published.vertices.Get(), before);
+  EXPECT_NE(model.GetMesh().vertices.Version(), published.vertices.Version());
+  EXPECT_EQ(model.GetMesh().faces.Version(), published.faces.Version());
+  EXPECT_EQ(model.GetFaces().Data(), published.faces.Get().Data());
+  EXPECT_FLOAT_EQ(model.GetVertices()[0], before[0] + 0.5f);
+
+  // После следующей публикации первый буфер свободен и используется снова.
+  published = model.GetMesh();
+  const float *second = published.vertices.Get().data();
+  model.Transform(delta);
+  EXPECT_EQ(model.GetVertices().data(), first);
+  published = model.GetMesh();
+  model.ResetTransform();
+  EXPECT_EQ(model.GetVertices().data(), second);
+  EXPECT_FLOAT_EQ(model.GetVertices()[0], before[0]);
+
+  // Без других владельцев вершины изменяются на месте.
+  published = {};
+  model.Transform(delta);
+  EXPECT_EQ(model.GetVertices().data(), second);
+}
+
+TEST(ModelTest, Stats) {
+  s21::Model model;
+  model.LoadFile("tests/files/cube_2.obj");
+  const MeshStats &stats = model.GetStats();
+  EXPECT_EQ(stats.vertices, model.GetVertices().size() / 3);
+  EXPECT_EQ(stats.edges, model.GetFaces().Size() / 2);
+  EXPECT_EQ(stats.vertices, 8u);
+  EXPECT_EQ(stats.edges, 17u);
+  EXPECT_EQ(stats.polygons, 10u);
+  EXPECT_EQ(stats.memory_bytes, 24 * 4u + 34 * 2u);
+  EXPECT_EQ(stats.index_size, 2u);
+  EXPECT_EQ(stats.saved_bytes, 34 * 2u);
+  EXPECT_GT(stats.load_seconds, 0);
+  std::array<float, 6> source_bbox{0, 0, 0, 2, 2, 2};
+  EXPECT_EQ(stats.bbox, source_bbox);
+
+  TransformParametrs delta = {{2, 2, 2}, {1, 0, 0}, {0, 0, 0}};
+  model.Transform(delta);
+  model.ResetTransform();
+  EXPECT_EQ(model.GetStats().bbox, source_bbox);
+
+  EXPECT_FALSE(model.LoadFile("tests/files/invalid_file.obj").first);
+  EXPECT_EQ(model.GetStats().vertices, 8u);
+}
+
 TEST(ModelTest, InvalidFile) {
   s21::Model model_;
   auto result = model_.LoadFile("tests/files/invalid_file.obj");
   EXPECT_FALSE(result.first);
   EXPECT_NE(result.second, "");
-}
\ No newline at end of file
+}
+
+TEST(ModelTest, CacheReload) {
+  namespace fs = std::filesystem;
+  std::string source = (fs::temp_directory_path() / "s21_cache_cube.obj");
+  fs::copy_file("tests/files/cube.obj", source,
+                fs::copy_options::overwrite_existing);
+  std::string cache = s21::MeshCache::CachePath(source);
+  fs::remove(cache);
+
+  s21::Model parsed;
+  parsed.SetCacheEnabled(true);
+  ASSERT_TRUE(parsed.LoadFile(source).first);
+  ASSERT_TRUE(fs::exists(cache));
+
+  s21::ObjectData data;
+  ASSERT_TRUE(s21::MeshCache::Load(source, data));
+  EXPECT_EQ(data.vertices, parsed.GetVertices());
+  EXPECT_EQ(data.faces, parsed.GetFaces());
+  EXPECT_FLOAT_EQ(data.stats.bbox[0], -1.0f);
+  EXPECT_FLOAT_EQ(data.stats.bbox[5], 1.0f);
+  EXPECT_EQ(data.stats.polygons, 12u);
+
+  s21::Model cached;
+  cached.SetCacheEnabled(true);
+  ASSERT_TRUE(cached.LoadFile(source).first);
+  EXPECT_EQ(cached.GetVertices(), parsed.GetVertices());
+  EXPECT_EQ(cached.GetFaces(), parsed.GetFaces());
+  EXPECT_TRUE(cached.GetStats().from_cache);
+  EXPECT_FALSE(parsed.GetStats().from_cache);
+  EXPECT_EQ(cached.GetStats().edges, parsed.GetStats().edges);
+  EXPECT_EQ(cached.GetStats().polygons, parsed.GetStats().polygons);
+
+  // Индекс за пределами вершин в кэше того же размера отвергается.
+  {
+    std::fstream file(cache, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(-2, std::ios::end);
+    file.write("\xff\xff", 2);
+  }
+  EXPECT_FALSE(s21::MeshCache::Load(source, data));
+
+  std::ofstream(source, std::ios::app) << "v 10 10 10\n";
+  EXPECT_FALSE(s21::MeshCache::Load(source, data));
+
+  fs::remove(cache);
+  fs::remove(source);
+}
+TEST(ModelTest, AsyncLoad) {
+  s21::ModelLoader loader;
+  s21::LoadResult result;
+  std::size_t reports = 0;
+  loader.Start(
+      "tests/files/cube.obj", false,
+      [&reports](const s21::LoadProgress&) { ++reports; },
+      [&result](s21::LoadResult loaded) { result = std::move(loaded); });
+  loader.Wait();
+  EXPECT_FALSE(loader.IsLoading());
+  ASSERT_TRUE(result.success);
+  EXPECT_GT(reports, 0u);
+
+  s21::Model expected;
+  expected.LoadFile("tests/files/cube.obj");
+  s21::Model model;
+  model.SetData(std::move(result.data));
+  EXPECT_EQ(model.GetVertices(), expected.GetVertices());
+  EXPECT_EQ(model.GetFaces(), expected.GetFaces());
+
+  loader.Start("tests/files/invalid_file.obj", false, {},
+               [&result](s21::LoadResult loaded) { result = std::move(loaded); });
+  loader.Wait();
+  EXPECT_FALSE(result.success);
+  EXPECT_FALSE(result.canceled);
+  EXPECT_NE(result.error, "");
+}
+
+TEST(ModelTest, AsyncLoadCancel) {
+  namespace fs = std::filesystem;
+  std::string source = (fs::temp_directory_path() / "s21_cancel_test.obj");
+  {
+    std::ofstream out(source);
+    for (int i = 0; i < 100000; ++i) out << "v " << i << " 1 2\n";
+  }
+  s21::ModelLoader loader;
+  s21::LoadResult result;
+  loader.Start(
+      source, false, [&loader](const s21::LoadProgress&) { loader.Cancel(); },
+      [&result](s21::LoadResult loaded) { result = std::move(loaded); });
+  loader.Wait();
+  EXPECT_FALSE(result.success);
+  EXPECT_TRUE(result.canceled);
+
+  // Новая загрузка отменяет предыдущую, не дожидаясь её.
+  s21::LoadResult first, second;
+  loader.Start(source, false, {},
+               [&first](s21::LoadResult loaded) { first = std::move(loaded); });
+  loader.Start("tests/files/cube.obj", false, {},
+               [&second](s21::LoadResult loaded) {
+                 second = std::move(loaded);
+               });
+  EXPECT_TRUE(loader.IsLoading() || second.success);
+  loader.Wait();
+  fs::remove(source);
+  EXPECT_TRUE(first.canceled);
+  EXPECT_TRUE(first.data.vertices.empty());
+  EXPECT_TRUE(second.success);
+}
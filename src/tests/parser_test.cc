@@ -2,11 +2,25 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <locale>
+#include <random>
+
+#include "../model/parser/edge_builder.h"
+#include "../model/parser/float_chars.h"
+#include "../model/parser/mesh_cache.h"
+
 TEST(ParserTest, CubeObject) {
   std::vector<unsigned int> expected_faces{
-      4, 2, 2, 0, 0, 4, 2, 7, 7, 3, 3, 2, 6, 5, 5, 7, 7, 6, 1, 7, 7, 5, 5, 1,
-      0, 3, 3, 1, 1, 0, 4, 1, 1, 5, 5, 4, 4, 6, 6, 2, 2, 4, 2, 6, 6, 7, 7, 2,
-      6, 4, 4, 5, 5, 6, 1, 3, 3, 7, 7, 1, 0, 2, 2, 3, 3, 0, 4, 0, 0, 1, 1, 4};
+      0, 1, 0, 2, 0, 3, 0, 4, 1, 3, 1, 4, 1, 5, 1, 7, 2, 3,
+      2, 4, 2, 6, 2, 7, 3, 7, 4, 5, 4, 6, 5, 6, 5, 7, 6, 7};
   std::vector<float> expected_vertices{1,  1,  -1, 1, -1, -1, 1,  1,
                                        1,  1,  -1, 1, -1, 1,  -1, -1,
                                        -1, -1, -1, 1, 1,  -1, -1, 1};
@@ -14,10 +28,10 @@ TEST(ParserTest, CubeObject) {
   s21::Parser parser{};
   parser.LoadFile("tests/files/cube.obj");
   s21::ObjectData data = parser.GetData();
-  EXPECT_EQ(data.faces.size(), expected_faces.size());
+  EXPECT_EQ(data.faces.Size(), expected_faces.size());
   EXPECT_EQ(data.vertices.size(), expected_vertices.size());
   for (size_t i = 0; i < expected_faces.size(); i++) {
-    EXPECT_EQ(expected_faces[i], data.faces.at(i));
+    EXPECT_EQ(expected_faces[i], data.faces[i]);
   }
   for (size_t i = 0; i < expected_vertices.size(); i++) {
     EXPECT_EQ(expected_vertices[i], data.vertices.at(i));
@@ -26,9 +40,8 @@ TEST(ParserTest, CubeObject) {
 
 TEST(ParserTest, CubeWithTextures) {
   std::vector<unsigned int> expected_faces{
-      1, 2, 2, 3, 3, 1, 7, 6, 6, 5, 5, 7, 4, 5, 5, 1, 1, 4, 5, 6, 6, 2, 2, 5,
-      2, 6, 6, 7, 7, 2, 0, 3, 3, 7, 7, 0, 0, 1, 1, 3, 3, 0, 4, 7, 7, 5, 5, 4,
-      0, 4, 4, 1, 1, 0, 1, 5, 5, 2, 2, 1, 3, 2, 2, 7, 7, 3, 4, 0, 0, 7, 7, 4};
+      0, 1, 0, 3, 0, 4, 0, 7, 1, 2, 1, 3, 1, 4, 1, 5, 2, 3,
+      2, 5, 2, 6, 2, 7, 3, 7, 4, 5, 4, 7, 5, 6, 5, 7, 6, 7};
 
   size_t expected_size_vertex = 24;
 
@@ -36,7 +49,7 @@ TEST(ParserTest, CubeWithTextures) {
 
   parser.LoadFile("tests/files/cube_with_textures.obj");
   s21::ObjectData data = parser.GetData();
-  EXPECT_EQ(data.faces.size(), expected_faces.size());
+  EXPECT_EQ(data.faces.Size(), expected_faces.size());
 
   EXPECT_EQ(data.vertices.size(), expected_size_vertex);
 
@@ -46,14 +59,13 @@ TEST(ParserTest, CubeWithTextures) {
 }
 
 TEST(ParserTest, FaceCheck) {
-  std::vector<unsigned int> expected_faces{0, 1, 1, 2, 2, 0, 0, 1, 1, 2, 2, 0,
-                                           0, 1, 1, 2, 2, 0, 0, 1, 1, 2, 2, 0};
+  std::vector<unsigned int> expected_faces{0, 1, 0, 2, 1, 2};
 
   s21::Parser parser;
 
   parser.LoadFile("tests/files/faces.obj");
   s21::ObjectData data = parser.GetData();
-  EXPECT_EQ(data.faces.size(), expected_faces.size());
+  EXPECT_EQ(data.faces.Size(), expected_faces.size());
 
   for (size_t i = 0; i < expected_faces.size(); i++) {
     EXPECT_EQ(expected_faces[i], data.faces[i]);
@@ -62,41 +74,269 @@ TEST(ParserTest, FaceCheck) {
 
 TEST(ParserTest, MultipleSpaces) {
   std::vector<unsigned int> expected_faces{
-      0, 6, 6, 4, 4, 0, 0, 2, 2, 6, 6, 0, 0, 3, 3, 2, 2, 0, 0, 1,
-      1, 3, 3, 0, 2, 7, 7, 6, 6, 2, 2, 3, 3, 7, 7, 2, 4, 6, 6, 7,
-      7, 4, 4, 7, 7, 5, 5, 4, 0, 4, 4, 5, 5, 0, 0, 5, 5, 1, 1, 0};
+      0, 1, 0, 2, 0, 3, 0, 4, 0, 5, 0, 6, 1, 3, 1, 5, 2, 3, 2, 6, 2, 7,
+      3, 7, 4, 5, 4, 6, 4, 7, 5, 7, 6, 7};
   s21::Parser parser;
 
   parser.LoadFile("tests/files/cube_2.obj");
   s21::ObjectData data = parser.GetData();
-  EXPECT_EQ(data.faces.size(), expected_faces.size());
+  EXPECT_EQ(data.faces.Size(), expected_faces.size());
   for (size_t i = 0; i < expected_faces.size(); i++) {
     EXPECT_EQ(expected_faces[i], data.faces[i]);
   }
 }
 
 TEST(ParserTest, OneFaceInLine) {
-  size_t expected_size{40};
+  size_t expected_size{18};
   s21::Parser parser;
 
   parser.LoadFile("tests/files/pyramid.obj");
   s21::ObjectData data = parser.GetData();
-  EXPECT_EQ(data.faces.size(), expected_size);
+  EXPECT_EQ(data.faces.Size(), expected_size);
 }
 
 TEST(ParserTest, NegativeFaces) {
-  std::vector<unsigned int> expected_faces{3, 2, 2, 1, 1, 3};
+  std::vector<unsigned int> expected_faces{1, 2, 1, 3, 2, 3};
 
   s21::Parser parser;
 
   parser.LoadFile("tests/files/negative_faces.obj");
   s21::ObjectData data = parser.GetData();
+  EXPECT_EQ(data.faces.Size(), expected_faces.size());
 
   for (size_t i = 0; i < expected_faces.size(); i++) {
     EXPECT_EQ(expected_faces[i], data.faces[i]);
   }
 }
 
+TEST(ParserTest, MappedModeMatchesStreamMode) {
+  const char* files[] = {"tests/files/cube.obj", "tests/files/cube_2.obj",
+                         "tests/files/cube_with_textures.obj",
+                         "tests/files/faces.obj", "tests/files/pyramid.obj",
+                         "tests/files/negative_faces.obj"};
+  for (const char* file : files) {
+    s21::Parser stream_parser;
+    stream_parser.SetLoadMode(s21::LoadMode::kStream);
+    stream_parser.LoadFile(file);
+    s21::Parser mapped_parser;
+    mapped_parser.SetLoadMode(s21::LoadMode::kMapped);
+    mapped_parser.LoadFile(file);
+    EXPECT_EQ(stream_parser.GetData().faces, mapped_parser.GetData().faces)
+        << file;
+    EXPECT_EQ(stream_parser.GetData().vertices,
+              mapped_parser.GetData().vertices)
+        << file;
+  }
+}
+
+TEST(ParserTest, ChunkedParseMatchesStreamMode) {
+  std::string path =
+      (std::filesystem::temp_directory_path() / "s21_chunked_test.obj")
+          .string();
+  {
+    std::ofstream out(path);
+    for (int i = 0; i < 250000; ++i) {
+      out << "v " << i << ".5 " << -i << " 0.25\n";
+      if (i % 3 == 2) out << "f -1 -2 -3\n";
+      if (i % 7 == 6) out << "f " << i - 5 << "/1/1 " << i + 1 << "//2 -4\n";
+    }
+  }
+  s21::Parser stream_parser;
+  stream_parser.SetLoadMode(s21::LoadMode::kStream);
+  stream_parser.LoadFile(path);
+  s21::Parser chunked_parser;
+  chunked_parser.SetThreadCount(4);
+  chunked_parser.LoadFile(path);
+  std::filesystem::remove(path);
+
+  EXPECT_EQ(stream_parser.GetData().vertices,
+            chunked_parser.GetData().vertices);
+  EXPECT_EQ(stream_parser.GetData().faces, chunked_parser.GetData().faces);
+}
+
+TEST(ParserTest, BoundsAndValidationInOnePass) {
+  std::string path =
+      (std::filesystem::temp_directory_path() / "s21_bounds_test.obj")
+          .string();
+  auto write = [&path](const std::string& tail) {
+    std::ofstream out(path);
+    for (int i = 0; i < 200000; ++i) {
+      out << "v " << i % 997 - 300 << ".25 " << i % 13 << " " << -i << "\n";
+      if (i % 2 == 1) out << "f -1 -2 " << i / 2 + 1 << "\n";
+    }
+    out << tail;
+  };
+  write("");
+  for (auto mode : {s21::LoadMode::kStream, s21::LoadMode::kMapped}) {
+    s21::Parser parser;
+    parser.SetLoadMode(mode);
+    parser.SetThreadCount(4);
+    parser.LoadFile(path);
+    std::array<float, 6> expected{-300.25f, 0, -199999, 696.25f, 12, 0};
+    EXPECT_EQ(parser.GetData().stats.bbox, expected);
+  }
+
+  const char* invalid[] = {"f 1 2 200001\n", "f 0 1 2\n",
+                           "f -1 -2 -200001\n"};
+  for (const char* tail : invalid) {
+    write(tail);
+    for (auto mode : {s21::LoadMode::kStream, s21::LoadMode::kMapped}) {
+      s21::Parser parser;
+      parser.SetLoadMode(mode);
+      parser.SetThreadCount(4);
+      EXPECT_THROW(parser.LoadFile(path), std::logic_error) << tail;
+    }
+  }
+  std::filesystem::remove(path);
+}
+
+namespace {
+
+struct CommaDecimal : std::numpunct<char> {
+  char do_decimal_point() const override { return ','; }
+};
+
+}  // namespace
+
+TEST(ParserTest, NumbersIgnoreLocaleAndRoundTrip) {
+  std::string path =
+      (std::filesystem::temp_directory_path() / "s21_numbers_test.obj")
+          .string();
+  std::vector<float> expected{1.5f,  -0.1f,   +2.0f,  3e2f,   -4.5E-3f,
+                              .25f,  7.0f,    1e-45f, 3.4028235e38f,
+                              1.17549435e-38f, 0.0f, -0.0f};
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<std::uint32_t> bits(0, 0x7f7fffffu);
+  for (int i = 0; i < 3000; ++i) {
+    std::uint32_t value = bits(gen) | (i % 2 ? 0x80000000u : 0u);
+    float number;
+    std::memcpy(&number, &value, sizeof(number));
+    expected.push_back(number);
+  }
+  {
+    std::ofstream out(path);
+    out << "v 1.5 -0.1 +2\nv 3e2 -4.5E-3 .25\nv 7. 1e-45 3.4028235e38\n"
+        << "v 1.17549435e-38 0 -0\n";
+    char buffer[32];
+    for (std::size_t i = 12; i < expected.size(); i += 3) {
+      out << 'v';
+      for (std::size_t j = i; j < i + 3; ++j) {
+        std::snprintf(buffer, sizeof(buffer), " %.9g", expected[j]);
+        out << buffer;
+      }
+      out << "\n";
+    }
+    out << "f 1/1/1 -1//2 2/3\nf +3 4 5\n";
+  }
+
+  std::locale previous = std::locale::global(
+      std::locale(std::locale::classic(), new CommaDecimal));
+  for (auto mode : {s21::LoadMode::kStream, s21::LoadMode::kMapped}) {
+    s21::Parser parser;
+    parser.SetLoadMode(mode);
+    parser.LoadFile(path);
+    const std::vector<float>& vertices = parser.GetData().vertices;
+    ASSERT_EQ(vertices.size(), expected.size());
+    EXPECT_EQ(std::memcmp(vertices.data(), expected.data(),
+                          expected.size() * sizeof(float)),
+              0);
+    unsigned int last = static_cast<unsigned int>(expected.size() / 3 - 1);
+    std::vector<unsigned int> edges{0, 1, 0, last, 1, last,
+                                    2, 3, 2, 4,    3, 4};
+    EXPECT_EQ(parser.GetData().faces.ToVector(), edges);
+  }
+  std::locale::global(previous);
+  std::filesystem::remove(path);
+}
+
+TEST(ParserTest, IndexWidthFollowsVertexCount) {
+  namespace fs = std::filesystem;
+  std::string path = (fs::temp_directory_path() / "s21_width_test.obj");
+  for (std::size_t count : {s21::IndexBuffer::kMaxShortVertices,
+                            s21::IndexBuffer::kMaxShortVertices + 1}) {
+    {
+      std::ofstream out(path);
+      for (std::size_t i = 0; i < count; ++i) out << "v " << i << " 0 0\n";
+      out << "f 1 2 " << count << "\n";
+    }
+    s21::Parser parser;
+    parser.LoadFile(path);
+    s21::ObjectData data = parser.TakeData();
+    bool narrow = count <= s21::IndexBuffer::kMaxShortVertices;
+    EXPECT_EQ(data.faces.Type(), narrow ? s21::IndexType::kUint16
+                                        : s21::IndexType::kUint32);
+    EXPECT_EQ(data.faces.Bytes(), 6 * (narrow ? 2u : 4u));
+
+    unsigned int last = static_cast<unsigned int>(count - 1);
+    std::vector<unsigned int> expected{0, 1, 0, last, 1, last};
+    EXPECT_EQ(data.faces.ToVector(), expected);
+    data.faces.Visit([&expected](const auto& indices) {
+      ASSERT_EQ(indices.size(), expected.size());
+      for (std::size_t i = 0; i < indices.size(); ++i) {
+        EXPECT_EQ(indices[i], expected[i]);
+      }
+    });
+
+    ASSERT_TRUE(s21::MeshCache::Save(path, data));
+    s21::ObjectData cached;
+    ASSERT_TRUE(s21::MeshCache::Load(path, cached));
+    EXPECT_EQ(cached.faces.Type(), data.faces.Type());
+    EXPECT_EQ(cached.faces, data.faces);
+    fs::remove(s21::MeshCache::CachePath(path));
+  }
+  fs::remove(path);
+
+  s21::IndexBuffer narrow({1, 2}, 3), wide({1, 2}, 70000);
+  EXPECT_EQ(narrow, wide);
+  EXPECT_EQ(wide[1], 2u);
+}
+
+TEST(ParserTest, UniqueEdges) {
+  std::vector<unsigned int> edges{2, 1, 1, 2, 3, 3, 0, 5, 5, 0, 1, 2};
+  s21::EdgeBuilder::BuildUniqueEdges(edges);
+  EXPECT_EQ(edges, (std::vector<unsigned int>{0, 5, 1, 2}));
+
+  std::vector<unsigned int> many;
+  for (unsigned int i = 0; i < 600000; ++i) {
+    unsigned int a = (i * 7919u) % 300000u, b = a + 1;
+    many.insert(many.end(), {b, a, a, b});
+  }
+  s21::EdgeBuilder::BuildUniqueEdges(many, 4);
+  ASSERT_EQ(many.size(), 600000u);
+  for (unsigned int i = 0; i < 300000; ++i) {
+    EXPECT_EQ(many[2 * i], i);
+    EXPECT_EQ(many[2 * i + 1], i + 1);
+  }
+}
+
+TEST(ParserTest, ProgressAndCancel) {
+  for (auto mode : {s21::LoadMode::kStream, s21::LoadMode::kMapped}) {
+    s21::Parser parser;
+    parser.SetLoadMode(mode);
+    s21::LoadProgress last;
+    parser.SetProgressCallback(
+        [&last](const s21::LoadProgress& progress) { last = progress; });
+    parser.LoadFile("tests/files/cube.obj");
+    EXPECT_EQ(last.bytes_parsed, last.bytes_total);
+    EXPECT_EQ(last.bytes_total,
+              std::filesystem::file_size("tests/files/cube.obj"));
+    EXPECT_EQ(last.vertices, 8u);
+    EXPECT_EQ(last.faces, 12u);
+
+    std::atomic<bool> cancel{true};
+    parser.SetCancelFlag(&cancel);
+    EXPECT_THROW(parser.LoadFile("tests/files/pyramid.obj"), s21::LoadCanceled);
+    EXPECT_EQ(parser.GetData().vertices.size(), 24u);
+  }
+}
+
+TEST(ParserTest, MissingFile) {
+  s21::Parser parser;
+  EXPECT_THROW(parser.LoadFile("tests/files/missing.obj"), std::exception);
+  parser.SetLoadMode(s21::LoadMode::kStream);
+  EXPECT_THROW(parser.LoadFile("tests/files/missing.obj"), std::exception);
+}
+
 TEST(ParserTest, InvalidFile) {
   EXPECT_THROW(
       {
@@ -108,4 +348,29 @@ TEST(ParserTest, InvalidFile) {
         }
       },
       std::exception);
-}
\ No newline at end of file
+}
+TEST(ParserTest, LocaleFloatFromCharsMatchesFromChars) {
+  // Запасной разбор для библиотек без std::from_chars для float должен
+  // принимать ту же запись и останавливаться в тех же местах.
+  auto same = [](double a, double b) {
+    return a == b || (std::isnan(a) && std::isnan(b));
+  };
+  for (const char* text :
+       {"1", "-2.5", ".5", "5.", "1e3", "1.5E-2x", "2e", "2e+", "1e-50", "1e50",
+        "-1e400", "0x1p3", "+1", "-", ".", "e5", " 1", "inf", "-Infinity",
+        "infx", "nan", "3,5",
+        "0.30000000000000004", "1.17549435e-38", "1e-40"}) {
+    const char* end = text + std::strlen(text);
+    float expected = -7, actual = -7;
+    auto reference = std::from_chars(text, end, expected);
+    auto fallback = s21::LocaleFloatFromChars(text, end, actual);
+    EXPECT_EQ(fallback.ec, reference.ec) << text;
+    EXPECT_EQ(fallback.ptr, reference.ptr) << text;
+    EXPECT_TRUE(same(actual, expected)) << text;
+
+    double wide_expected = -7, wide_actual = -7;
+    std::from_chars(text, end, wide_expected);
+    s21::LocaleFloatFromChars(text, end, wide_actual);
+    EXPECT_TRUE(same(wide_actual, wide_expected)) << text;
+  }
+}
@@ -0,0 +1,318 @@
+#include "../model/render/software_renderer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../model/model.h"
+#include "../model/render/gif_recorder.h"
+
+using namespace s21;
+
+namespace {
+
+const std::array<float, 16> kIdentity{1, 0, 0, 0, 0, 1, 0, 0,
+                                      0, 0, 1, 0, 0, 0, 0, 1};
+
+bool IsColor(const SoftwareRenderer &renderer, int x, int y,
+             const Rgba &color) {
+  const std::uint8_t *pixel =
+      &renderer.Pixels()[(static_cast<std::size_t>(y) * renderer.Width() + x) *
+                         4];
+  return pixel[0] == color.r && pixel[1] == color.g && pixel[2] == color.b &&
+         pixel[3] == color.a;
+}
+
+int CountColor(const SoftwareRenderer &renderer, const Rgba &color) {
+  int count = 0;
+  for (int y = 0; y < renderer.Height(); ++y) {
+    for (int x = 0; x < renderer.Width(); ++x) {
+      count += IsColor(renderer, x, y, color);
+    }
+  }
+  return count;
+}
+
+// Распаковывает индексы палитры всех кадров GIF без проверки формата.
+std::vector<std::vector<std::uint8_t>> DecodeGifFrames(const std::string &gif) {
+  std::vector<std::vector<std::uint8_t>> frames;
+  auto byte = [&gif](std::size_t pos) {
+    return static_cast<std::uint8_t>(gif.at(pos));
+  };
+  std::size_t pos = 13;
+  if (byte(10) & 0x80) pos += 3 * (2u << (byte(10) & 7));
+  while (pos < gif.size() && byte(pos) != 0x3B) {
+    std::uint8_t block = byte(pos++);
+    if (block == 0x21) {
+      for (++pos; byte(pos); pos += byte(pos) + 1) {
+      }
+      ++pos;
+      continue;
+    }
+    std::uint8_t flags = byte(pos + 8);
+    pos += 9;
+    if (flags & 0x80) pos += 3 * (2u << (flags & 7));
+    int min_code = byte(pos++);
+    std::string data;
+    for (; byte(pos); pos += byte(pos) + 1) {
+      data += gif.substr(pos + 1, byte(pos));
+    }
+    ++pos;
+
+    const int clear = 1 << min_code;
+    std::vector<std::vector<std::uint8_t>> dictionary;
+    int code_size = min_code + 1, previous = -1;
+    auto reset = [&] {
+      dictionary.assign(clear + 2, {});
+      for (int i = 0; i < clear; ++i) {
+        dictionary[i] = {static_cast<std::uint8_t>(i)};
+      }
+      code_size = min_code + 1;
+      previous = -1;
+    };
+    reset();
+    std::vector<std::uint8_t> frame;
+    for (std::size_t bit = 0; bit + code_size <= data.size() * 8;) {
+      int code = 0;
+      for (int i = 0; i < code_size; ++i, ++bit) {
+        code |= ((static_cast<std::uint8_t>(data[bit / 8]) >> (bit % 8)) & 1)
+                << i;
+      }
+      if (code == clear) {
+        reset();
+        continue;
+      }
+      if (code == clear + 1) break;
+      std::vector<std::uint8_t> entry;
+      if (code < static_cast<int>(dictionary.size())) {
+        entry = dictionary[code];
+      } else {
+        entry = dictionary[previous];
+        entry.push_back(entry.front());
+      }
+      frame.insert(frame.end(), entry.begin(), entry.end());
+      if (previous >= 0 && dictionary.size() < 4096) {
+        dictionary.push_back(dictionary[previous]);
+        dictionary.back().push_back(entry.front());
+      }
+      previous = code;
+      if (static_cast<int>(dictionary.size()) == 1 << code_size &&
+          code_size < 12) {
+        ++code_size;
+      }
+    }
+    frames.push_back(frame);
+  }
+  return frames;
+}
+
+// Число пикселей с прозрачным индексом 0, которым gif.h помечает
+// неизменившиеся пиксели.
+std::size_t CountTransparent(const std::vector<std::uint8_t> &frame) {
+  return std::count(frame.begin(), frame.end(), 0);
+}
+
+}  // namespace
+
+TEST(RenderTest, LinesAcrossTiles) {
+  SoftwareRenderer renderer;
+  RenderSettings settings;
+  settings.vertex_shape = PointShape::kNone;
+  std::vector<float> vertices{-0.9f, 0, 0, 0.9f, 0, 0};
+  IndexBuffer faces({0, 1}, 2);
+
+  // Центры столбцов 13..242 лежат в [12.8, 243.2), строка 32.
+  renderer.Render(256, 64, vertices, faces, kIdentity, settings);
+  EXPECT_EQ(CountColor(renderer, settings.edges_color), 230);
+  EXPECT_TRUE(IsColor(renderer, 13, 32, settings.edges_color));
+  EXPECT_TRUE(IsColor(renderer, 242, 32, settings.edges_color));
+  EXPECT_TRUE(IsColor(renderer, 12, 32, settings.background));
+  EXPECT_TRUE(IsColor(renderer, 100, 31, settings.background));
+
+  settings.edges_size = 3;
+  renderer.Render(256, 64, vertices, faces, kIdentity, settings);
+  EXPECT_EQ(CountColor(renderer, settings.edges_color), 230 * 3);
+  EXPECT_TRUE(IsColor(renderer, 100, 31, settings.edges_color));
+  EXPECT_TRUE(IsColor(renderer, 100, 33, settings.edges_color));
+
+  // Пунктир 8 через 8 отсчитывается от первой вершины.
+  settings.edges_size = 1;
+  settings.dashed_edges = true;
+  renderer.Render(256, 64, vertices, faces, kIdentity, settings);
+  EXPECT_EQ(CountColor(renderer, settings.edges_color), 118);
+  EXPECT_TRUE(IsColor(renderer, 20, 32, settings.edges_color));
+  EXPECT_TRUE(IsColor(renderer, 21, 32, settings.background));
+  EXPECT_TRUE(IsColor(renderer, 29, 32, settings.edges_color));
+}
+
+TEST(RenderTest, PointsAndDepth) {
+  SoftwareRenderer renderer;
+  RenderSettings settings;
+  settings.vertex_color = {255, 0, 0, 255};
+  settings.vertex_shape = PointShape::kSquare;
+  // Ребро ближе к наблюдателю (z = 1), отдельная вершина дальше (z = -1).
+  std::vector<float> vertices{-0.5f, 0, 1, 0.5f, 0, 1, 0, 0, -1};
+  renderer.Render(100, 50, vertices, IndexBuffer({0, 1}, 3), kIdentity,
+                  settings);
+  EXPECT_TRUE(IsColor(renderer, 50, 25, settings.edges_color));
+  EXPECT_TRUE(IsColor(renderer, 50, 23, settings.vertex_color));
+  EXPECT_TRUE(IsColor(renderer, 52, 27, settings.vertex_color));
+  EXPECT_TRUE(IsColor(renderer, 53, 23, settings.background));
+
+  std::vector<float> single{0, 0, 0};
+  renderer.Render(100, 50, single, IndexBuffer(), kIdentity, settings);
+  EXPECT_EQ(CountColor(renderer, settings.vertex_color), 25);
+  settings.vertex_shape = PointShape::kRound;
+  renderer.Render(100, 50, single, IndexBuffer(), kIdentity, settings);
+  EXPECT_EQ(CountColor(renderer, settings.vertex_color), 16);
+  settings.vertex_shape = PointShape::kNone;
+  renderer.Render(100, 50, single, IndexBuffer(), kIdentity, settings);
+  EXPECT_EQ(CountColor(renderer, settings.background), 100 * 50);
+}
+
+TEST(RenderTest, PerspectiveClipping) {
+  SoftwareRenderer renderer;
+  RenderSettings settings;
+  settings.parallel_projection = false;
+  settings.vertex_shape = PointShape::kNone;
+  // Наблюдатель находится в z = 2: первое ребро пересекает его плоскость,
+  // второе целиком позади, третье выходит далеко за край кадра.
+  std::vector<float> vertices{0, 0, 0,   0.5f, 0, 5,  0, 0.5f, 3,
+                              0, 0.5f, 4, -50, 0, 0,  50, 0,   0};
+  renderer.Render(200, 100, vertices, IndexBuffer({0, 1}, 6), kIdentity,
+                  settings);
+  EXPECT_TRUE(IsColor(renderer, 100, 50, settings.edges_color));
+  EXPECT_GT(CountColor(renderer, settings.edges_color), 1);
+
+  renderer.Render(200, 100, vertices, IndexBuffer({2, 3}, 6), kIdentity,
+                  settings);
+  EXPECT_EQ(CountColor(renderer, settings.edges_color), 0);
+
+  renderer.Render(200, 100, vertices, IndexBuffer({4, 5}, 6), kIdentity,
+                  settings);
+  EXPECT_EQ(CountColor(renderer, settings.edges_color), 200);
+
+  EXPECT_THROW(renderer.Render(200, 100, vertices, IndexBuffer({0, 6}, 6),
+                               kIdentity, settings),
+               std::invalid_argument);
+  EXPECT_THROW(
+      renderer.Render(0, 100, vertices, IndexBuffer(), kIdentity, settings),
+      std::invalid_argument);
+}
+
+TEST(RenderTest, ModelFrameDoesNotDependOnIndexWidth) {
+  Model model;
+  model.LoadFile("tests/files/cube.obj");
+  TransformParametrs delta = {{0, 0, 0}, {0, 0, 0}, {0.4f, 0.7f, 0}};
+  model.Transform(delta);
+  RenderSettings settings;
+  settings.parallel_projection = false;
+  settings.dashed_edges = true;
+
+  const IndexBuffer &narrow = model.GetFaces();
+  ASSERT_EQ(narrow.Type(), IndexType::kUint16);
+  IndexBuffer wide(narrow.ToVector(), IndexBuffer::kMaxShortVertices + 1);
+  SoftwareRenderer first, second;
+  first.Render(320, 240, model.GetVertices(), narrow, model.GetModelMatrix(),
+               settings);
+  second.Render(320, 240, model.GetVertices(), wide, model.GetModelMatrix(),
+                settings);
+  EXPECT_EQ(first.Pixels(), second.Pixels());
+  EXPECT_GT(CountColor(first, settings.edges_color), 100);
+  EXPECT_GT(CountColor(first, settings.vertex_color), 0);
+}
+
+TEST(RenderTest, GifRecorderEncodesQueuedFrames) {
+  std::string path =
+      (std::filesystem::temp_directory_path() / "s21_recorder_test.gif")
+          .string();
+  SoftwareRenderer renderer;
+  RenderSettings settings;
+  std::vector<float> vertices{-0.9f, -0.9f, 0, 0.9f, 0.9f, 0};
+  std::string error = "not finished";
+  {
+    GifRecorder recorder(
+        path, 32, 24, 10, [&error](const std::string &e) { error = e; }, 2);
+    for (int frame = 0; frame < 6; ++frame) {
+      settings.edges_size = 1 + frame % 3;
+      renderer.Render(32, 24, vertices, IndexBuffer({0, 1}, 2), kIdentity,
+                      settings);
+      EXPECT_TRUE(recorder.Push(renderer.Pixels()));
+    }
+    EXPECT_THROW(recorder.Push(std::vector<std::uint8_t>(4)),
+                 std::invalid_argument);
+    recorder.Close();
+    EXPECT_FALSE(recorder.Push(renderer.Pixels()));
+    EXPECT_EQ(recorder.TryPush(renderer.Pixels()),
+              GifRecorder::PushResult::kClosed);
+    recorder.Wait();
+    EXPECT_EQ(error, "");
+  }
+  std::ifstream file(path, std::ios::binary);
+  std::string gif((std::istreambuf_iterator<char>(file)), {});
+  EXPECT_EQ(gif.substr(0, 6), "GIF89a");
+  EXPECT_EQ(gif.back(), '\x3b');
+  // Шесть кадров: у каждого свой блок управления графикой.
+  std::size_t frames = 0;
+  for (std::size_t pos = gif.find("\x21\xF9\x04"); pos != std::string::npos;
+       pos = gif.find("\x21\xF9\x04", pos + 1)) {
+    ++frames;
+  }
+  EXPECT_EQ(frames, 6u);
+  std::filesystem::remove(path);
+
+  EXPECT_THROW(GifRecorder("/nonexistent/dir/a.gif", 32, 24, 10),
+               std::runtime_error);
+}
+
+TEST(RenderTest, GifDitherModesEncodeStillFrames) {
+  const int width = 64, height = 48;
+  std::vector<std::uint8_t> gradient(width * height * 4);
+  for (std::size_t i = 0; i < gradient.size(); i += 4) {
+    std::size_t x = i / 4 % width, y = i / 4 / width;
+    gradient[i] = static_cast<std::uint8_t>(x * 4);
+    gradient[i + 1] = static_cast<std::uint8_t>(y * 5);
+    gradient[i + 2] = static_cast<std::uint8_t>((x + y) * 2);
+    gradient[i + 3] = 255;
+  }
+  std::vector<std::uint8_t> inverted = gradient;
+  for (std::size_t i = 0; i < inverted.size(); i += 4) {
+    for (std::size_t c = 0; c < 3; ++c) inverted[i + c] ^= 0xFF;
+  }
+  std::string path =
+      (std::filesystem::temp_directory_path() / "s21_dither_test.gif")
+          .string();
+  auto encode = [&](GifDither dither, const std::vector<std::uint8_t> &next) {
+    GifEncoder gif(path, width, height, 10, dither);
+    gif.AddFrame(gradient);
+    gif.AddFrame(next);
+    gif.Finish();
+    std::ifstream file(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)), {});
+  };
+  const std::size_t pixels = width * height;
+  for (GifDither dither : {GifDither::kNone, GifDither::kFloydSteinberg,
+                           GifDither::kOrdered}) {
+    std::string gif = encode(dither, inverted);
+    EXPECT_EQ(gif.substr(0, 6), "GIF89a");
+    EXPECT_EQ(gif.back(), '\x3b');
+    // Изменившийся кадр записывается, а не заменяется прозрачными пикселями.
+    std::vector<std::vector<std::uint8_t>> frames = DecodeGifFrames(gif);
+    ASSERT_EQ(frames.size(), 2u);
+    ASSERT_EQ(frames[1].size(), pixels);
+    EXPECT_EQ(CountTransparent(frames[0]), 0u);
+    EXPECT_LT(CountTransparent(frames[1]), pixels / 10);
+  }
+  // Упорядоченный дизеринг повторяет цвета предыдущего кадра, поэтому
+  // неподвижный кадр целиком прозрачен.
+  std::vector<std::vector<std::uint8_t>> still =
+      DecodeGifFrames(encode(GifDither::kOrdered, gradient));
+  ASSERT_EQ(still.size(), 2u);
+  EXPECT_EQ(CountTransparent(still[1]), pixels);
+  std::filesystem::remove(path);
+}
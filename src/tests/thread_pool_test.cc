@@ -0,0 +1,92 @@
+#include "../model/concurrency/thread_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "../model/concurrency/bounded_queue.h"
+
+using namespace s21;
+
+TEST(ThreadPoolTest, ParallelForCoversRange) {
+  ThreadPool pool{3};
+  EXPECT_EQ(pool.Size(), 4u);
+  for (std::size_t count : {0, 1, 7, 100, 100003}) {
+    std::vector<int> hits(count, 0);
+    std::atomic<int> parts{0};
+    pool.ParallelFor(count, 10, [&](std::size_t begin, std::size_t end) {
+      ++parts;
+      for (std::size_t i = begin; i < end; ++i) ++hits[i];
+    });
+    EXPECT_EQ(std::accumulate(hits.begin(), hits.end(), std::size_t{0}),
+              count);
+    for (int hit : hits) ASSERT_EQ(hit, 1);
+    EXPECT_LE(parts, 4);
+    if (count < 20) {
+      EXPECT_LE(parts, 1);
+    }
+  }
+}
+
+TEST(ThreadPoolTest, RunNestedAndRethrows) {
+  ThreadPool pool{2};
+  std::atomic<int> sum{0};
+  pool.Run(8, [&](std::size_t i) {
+    pool.Run(4, [&](std::size_t j) { sum += static_cast<int>(i * 4 + j); });
+  });
+  EXPECT_EQ(sum, 31 * 32 / 2);
+
+  std::atomic<int> done{0};
+  EXPECT_THROW(pool.Run(16,
+                        [&](std::size_t i) {
+                          ++done;
+                          if (i == 5) throw std::runtime_error("task");
+                        }),
+               std::runtime_error);
+  EXPECT_EQ(done, 16);
+}
+
+TEST(ThreadPoolTest, SerialPool) {
+  ThreadPool pool{0};
+  std::vector<std::size_t> order;
+  pool.Run(5, [&](std::size_t i) { order.push_back(i); });
+  EXPECT_EQ(order, (std::vector<std::size_t>{0, 1, 2, 3, 4}));
+}
+
+TEST(BoundedQueueTest, BlocksWhenFullAndDrainsAfterClose) {
+  BoundedQueue<int> queue{2};
+  std::atomic<int> pushed{0};
+  std::thread producer([&] {
+    for (int i = 0; i < 5; ++i) {
+      queue.Push(i);
+      ++pushed;
+    }
+    queue.Close();
+  });
+  while (queue.Size() < 2) std::this_thread::yield();
+  EXPECT_LE(pushed, 2);
+  std::vector<int> popped;
+  while (auto value = queue.Pop()) popped.push_back(*value);
+  producer.join();
+  EXPECT_EQ(popped, (std::vector<int>{0, 1, 2, 3, 4}));
+  EXPECT_FALSE(queue.Push(5));
+  EXPECT_FALSE(queue.Pop().has_value());
+}
+
+TEST(BoundedQueueTest, TryPushDoesNotWait) {
+  BoundedQueue<std::vector<int>> queue{1};
+  std::vector<int> first{1}, second{2};
+  EXPECT_TRUE(queue.TryPush(first));
+  EXPECT_TRUE(first.empty());
+  EXPECT_FALSE(queue.TryPush(second));
+  EXPECT_EQ(second, std::vector<int>{2});
+  EXPECT_FALSE(queue.IsClosed());
+  queue.Close();
+  EXPECT_TRUE(queue.IsClosed());
+  EXPECT_EQ(*queue.Pop(), std::vector<int>{1});
+  EXPECT_FALSE(queue.TryPush(second));
+}
@@ -29,6 +29,7 @@ int main(int argc, char *argv[]) {
   QCoreApplication::setAttribute(Qt::AA_DontUseNativeMenuBar);
   QApplication a(argc, argv);
   s21::Model model;
+  model.SetTransformMode(s21::TransformMode::kRetained);
   s21::View w;
   s21::Controller controller(&model, &w);
   w.show();
@@ -8,45 +8,173 @@
  * а также отрисовку рёбер и точек модели. Методы используют настройки, такие
  * как цвет фона, тип и толщина линий, размер и форма вершин.
  *
+ * Вершины и индексы рёбер хранятся в буферах видеокарты (VBO и IBO) и
+ * передаются туда только после изменения модели, а не в каждом кадре.
+ *
+ * Кроме фиксированного конвейера доступна шейдерная отрисовка: VAO, шейдеры
+ * GLSL 3.30 core и матрицы модели, вида и проекции в uniform-переменных.
+ * Пунктир рёбер и круглые точки строятся во фрагментном шейдере вместо
+ * устаревших `glLineStipple` и `GL_POINT_SMOOTH`.
+ *
  * Все функции взаимодействуют с OpenGL для отображения 3D-графики в окне
  * приложения.
  */
 
 #include "view.h"
 
+#ifndef GL_PROGRAM_POINT_SIZE
+#define GL_PROGRAM_POINT_SIZE 0x8642
+#endif
+
 namespace s21 {
 
+namespace {
+
+/// Режимы фрагментного шейдера (`u_mode`)
+constexpr int kSolidMode = 0;   ///< Сплошная линия или квадратная точка
+constexpr int kDashedMode = 1;  ///< Пунктир 8 пикселей через 8
+constexpr int kRoundMode = 2;   ///< Круглая точка
+
+constexpr const char* kVertexShader = R"(#version 330 core
+layout(location = 0) in vec3 position;
+uniform mat4 u_model;
+uniform mat4 u_view;
+uniform mat4 u_projection;
+uniform vec2 u_viewport;
+uniform float u_point_size;
+noperspective out vec2 v_screen;
+flat out vec2 v_start;
+void main() {
+  gl_Position = u_projection * u_view * u_model * vec4(position, 1.0);
+  v_screen = gl_Position.xy / gl_Position.w * 0.5 * u_viewport;
+  v_start = v_screen;
+  gl_PointSize = u_point_size;
+}
+)";
+
+// v_start одинаков для всех фрагментов линии и равен экранной позиции одного
+// из её концов, поэтому расстояние до него задаёт фазу пунктира, как
+// glLineStipple(1, 0x00FF).
+constexpr const char* kFragmentShader = R"(#version 330 core
+noperspective in vec2 v_screen;
+flat in vec2 v_start;
+uniform vec4 u_color;
+uniform int u_mode;
+out vec4 fragment;
+void main() {
+  if (u_mode == 1 && mod(distance(v_screen, v_start), 16.0) >= 8.0) discard;
+  if (u_mode == 2 && distance(gl_PointCoord, vec2(0.5)) > 0.5) discard;
+  fragment = u_color;
+}
+)";
+
+GLenum IndexGlType(const IndexBuffer& faces) {
+  return faces.Type() == IndexType::kUint16 ? GL_UNSIGNED_SHORT
+                                            : GL_UNSIGNED_INT;
+}
+
+}  // namespace
+
 s21::ModelRender::ModelRender(QWidget* parent) : QOpenGLWidget(parent) {
   loadSettings();
 }
 
 s21::ModelRender::~ModelRender() {
   makeCurrent();
+  vertex_buffer_.destroy();
+  index_buffer_.destroy();
   doneCurrent();
 }
 
-void s21::ModelRender::setModelData(const std::vector<float>& vertices,
-                                    const std::vector<unsigned int>& faces) {
-  vertices_ = vertices;
-  faces_ = faces;
+void s21::ModelRender::setModelData(const MeshBuffer& mesh) {
+  if (mesh.vertices.Version() == mesh_.vertices.Version() &&
+      mesh.faces.Version() == mesh_.faces.Version()) {
+    return;
+  }
+  mesh_ = mesh;
+  update();
+}
+
+void s21::ModelRender::setModelMatrix(const std::array<float, 16>& matrix) {
+  model_matrix_ = matrix;
   update();
 }
 
-std::vector<float> s21::ModelRender::GetVertices() { return vertices_; }
+const std::vector<float>& s21::ModelRender::GetVertices() const {
+  return mesh_.vertices.Get();
+}
 
-std::vector<unsigned int> s21::ModelRender::GetFaces() { return faces_; }
+const IndexBuffer& s21::ModelRender::GetFaces() const {
+  return mesh_.faces.Get();
+}
 
 void s21::ModelRender::initializeGL() {
   initializeOpenGLFunctions();
   glClearColor(settings_.bg_color.redF(), settings_.bg_color.greenF(),
                settings_.bg_color.blueF(), 1.0f);
   glEnable(GL_DEPTH_TEST);
+  vertex_buffer_.destroy();
+  index_buffer_.destroy();
+  vertex_buffer_.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+  index_buffer_.setUsagePattern(QOpenGLBuffer::StaticDraw);
+  vertex_buffer_.create();
+  index_buffer_.create();
+  // Буферы нового контекста пусты: данные модели передаются заново.
+  uploaded_vertices_ = uploaded_faces_ = 0;
+  shaders_ready_ = InitShaders();
+  emit shadersAvailabilityChanged(shaders_ready_);
+}
+
+bool s21::ModelRender::InitShaders() {
+  vao_.destroy();
+  program_.removeAllShaders();
+  if (!program_.addShaderFromSourceCode(QOpenGLShader::Vertex,
+                                        kVertexShader) ||
+      !program_.addShaderFromSourceCode(QOpenGLShader::Fragment,
+                                        kFragmentShader) ||
+      !program_.link() || !vao_.create()) {
+    qWarning() << "Shader renderer is unavailable:" << program_.log();
+    return false;
+  }
+  vao_.bind();
+  vertex_buffer_.bind();
+  program_.enableAttributeArray(0);
+  program_.setAttributeBuffer(0, GL_FLOAT, 0, 3);
+  index_buffer_.bind();
+  vao_.release();
+  vertex_buffer_.release();
+  index_buffer_.release();
+  return true;
+}
+
+void s21::ModelRender::UploadMesh() {
+  if (mesh_.vertices.Version() != uploaded_vertices_) {
+    const std::vector<float>& vertices = GetVertices();
+    int bytes = static_cast<int>(vertices.size() * sizeof(float));
+    vertex_buffer_.bind();
+    if (bytes == vertex_buffer_.size()) {
+      vertex_buffer_.write(0, vertices.data(), bytes);
+    } else {
+      vertex_buffer_.allocate(vertices.data(), bytes);
+    }
+    uploaded_vertices_ = mesh_.vertices.Version();
+  }
+  if (mesh_.faces.Version() != uploaded_faces_) {
+    const IndexBuffer& faces = GetFaces();
+    index_buffer_.bind();
+    index_buffer_.allocate(faces.Data(), static_cast<int>(faces.Bytes()));
+    uploaded_faces_ = mesh_.faces.Version();
+  }
 }
 
 void s21::ModelRender::resizeGL(int w, int h) { glViewport(0, 0, w, h); }
 
 void s21::ModelRender::paintGL() {
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  if (settings_.use_shaders && shaders_ready_) {
+    PaintWithShaders();
+    return;
+  }
   glMatrixMode(GL_PROJECTION);
   glLoadIdentity();
   int winWidth = width();
@@ -67,12 +195,70 @@ void s21::ModelRender::paintGL() {
   }
   glMatrixMode(GL_MODELVIEW);
   glLoadIdentity();
-  if (!vertices_.empty() && !faces_.empty()) {
+  glMultMatrixf(model_matrix_.data());
+  if (!GetVertices().empty() && !GetFaces().Empty()) {
+    UploadMesh();
+    vertex_buffer_.bind();
+    index_buffer_.bind();
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, nullptr);
     BuildLines();
     BuildPoints();
+    glDisableClientState(GL_VERTEX_ARRAY);
+    index_buffer_.release();
+    vertex_buffer_.release();
   }
 }
 
+void s21::ModelRender::PaintWithShaders() {
+  if (GetVertices().empty() || GetFaces().Empty()) return;
+  UploadMesh();
+  QMatrix4x4 projection, view;
+  if (settings_.is_parallel_projection) {
+    projection.ortho(-1.0f, 1.0f, -1.0f, 1.0f, -10.0f, 10.0f);
+  } else {
+    projection.perspective(60.0f, static_cast<float>(width()) / height(),
+                           0.1f, 100.0f);
+    view.translate(0.0f, 0.0f, -2.0f);
+  }
+  // model_matrix_ записана по столбцам, а конструктор QMatrix4x4 читает
+  // элементы по строкам.
+  QMatrix4x4 model = QMatrix4x4(model_matrix_.data()).transposed();
+  qreal ratio = devicePixelRatioF();
+
+  glDisable(GL_LINE_STIPPLE);
+  glDisable(GL_POINT_SMOOTH);
+  glEnable(GL_PROGRAM_POINT_SIZE);
+  program_.bind();
+  program_.setUniformValue("u_model", model);
+  program_.setUniformValue("u_view", view);
+  program_.setUniformValue("u_projection", projection);
+  program_.setUniformValue(
+      "u_viewport", QVector2D(width() * ratio, height() * ratio));
+  vao_.bind();
+
+  const IndexBuffer& faces = GetFaces();
+  glLineWidth(settings_.edges_size);
+  program_.setUniformValue("u_color", settings_.edges_color);
+  program_.setUniformValue("u_mode",
+                           settings_.line_type == 1 ? kSolidMode : kDashedMode);
+  glDrawElements(GL_LINES, static_cast<GLsizei>(faces.Size()),
+                 IndexGlType(faces), nullptr);
+
+  if (settings_.vertex_shape != 0) {
+    program_.setUniformValue("u_color", settings_.vertex_color);
+    program_.setUniformValue("u_point_size",
+                             static_cast<GLfloat>(settings_.vertex_size));
+    program_.setUniformValue(
+        "u_mode", settings_.vertex_shape == 1 ? kRoundMode : kSolidMode);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(GetVertices().size() / 3));
+  }
+
+  vao_.release();
+  program_.release();
+  glDisable(GL_PROGRAM_POINT_SIZE);
+}
+
 void s21::ModelRender::BuildLines() {
   glLineWidth(settings_.edges_size);
   if (settings_.line_type == 1) {
@@ -83,11 +269,9 @@ void s21::ModelRender::BuildLines() {
   }
   glColor3f(settings_.edges_color.redF(), settings_.edges_color.greenF(),
             settings_.edges_color.blueF());
-  glEnableClientState(GL_VERTEX_ARRAY);
-  glVertexPointer(3, GL_FLOAT, 0, vertices_.data());
-  glDrawElements(GL_LINES, static_cast<GLsizei>(faces_.size()), GL_UNSIGNED_INT,
-                 faces_.data());
-  glDisableClientState(GL_VERTEX_ARRAY);
+  const IndexBuffer& faces = GetFaces();
+  glDrawElements(GL_LINES, static_cast<GLsizei>(faces.Size()),
+                 IndexGlType(faces), nullptr);
 }
 
 void s21::ModelRender::BuildPoints() {
@@ -97,17 +281,15 @@ void s21::ModelRender::BuildPoints() {
   if (settings_.vertex_shape == 0) {
     return;
   }
-  glEnableClientState(GL_VERTEX_ARRAY);
-  glVertexPointer(3, GL_FLOAT, 0, vertices_.data());
+  const std::vector<float>& vertices = GetVertices();
   if (settings_.vertex_shape == 1) {
     glEnable(GL_POINT_SMOOTH);
-    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(vertices_.size() / 3));
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(vertices.size() / 3));
     glDisable(GL_POINT_SMOOTH);
   } else if (settings_.vertex_shape == 2) {
     glDisable(GL_POINT_SMOOTH);
-    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(vertices_.size() / 3));
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(vertices.size() / 3));
   }
-  glDisableClientState(GL_VERTEX_ARRAY);
 }
 
 void s21::ModelRender::setBackgroundColor(const QColor& color) {
@@ -177,6 +359,38 @@ void s21::ModelRender::setProjectionType(bool isParallel) {
   }
 }
 
+void s21::ModelRender::setShaderRendering(bool enabled) {
+  if (enabled != settings_.use_shaders) {
+    settings_.use_shaders = enabled;
+    saveSettings();
+    update();
+  }
+}
+
+QImage s21::ModelRender::renderSoftware(const QSize& size) const {
+  auto rgba = [](const QColor& color) {
+    return Rgba{static_cast<std::uint8_t>(color.red()),
+                static_cast<std::uint8_t>(color.green()),
+                static_cast<std::uint8_t>(color.blue()), 255};
+  };
+  RenderSettings settings;
+  settings.background = rgba(settings_.bg_color);
+  settings.edges_color = rgba(settings_.edges_color);
+  settings.vertex_color = rgba(settings_.vertex_color);
+  settings.edges_size = settings_.edges_size;
+  settings.dashed_edges = settings_.line_type != 1;
+  settings.vertex_size = settings_.vertex_size;
+  settings.vertex_shape = static_cast<PointShape>(settings_.vertex_shape);
+  settings.parallel_projection = settings_.is_parallel_projection;
+
+  SoftwareRenderer renderer;
+  renderer.Render(size.width(), size.height(), GetVertices(), GetFaces(),
+                  model_matrix_, settings);
+  return QImage(renderer.Pixels().data(), renderer.Width(), renderer.Height(),
+                QImage::Format_RGBA8888)
+      .copy();
+}
+
 void s21::ModelRender::defaultEdgesSettings() {
   settings_.edges_color = QColor(255, 255, 255);
   settings_.line_type = 1;
@@ -207,6 +421,7 @@ void s21::ModelRender::loadSettings() {
   settings_.vertex_shape = settings.value("vertex_shape", 1).toInt();
   settings_.is_parallel_projection =
       settings.value("is_parallel_projection", true).toBool();
+  settings_.use_shaders = settings.value("use_shaders", false).toBool();
 }
 
 void s21::ModelRender::saveSettings() const {
@@ -219,6 +434,7 @@ void s21::ModelRender::saveSettings() const {
   settings.setValue("vertex_shape", settings_.vertex_shape);
   settings.setValue("vertex_size", settings_.vertex_size);
   settings.setValue("is_parallel_projection", settings_.is_parallel_projection);
+  settings.setValue("use_shaders", settings_.use_shaders);
 }
 
 const s21::Settings& ModelRender::getSettings() const { return settings_; }
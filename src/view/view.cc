@@ -17,11 +17,21 @@
 
 #include "view.h"
 
-#include "../libs/gif.h"
 #include "ui_view.h"
 
 namespace s21 {
 
+namespace {
+
+/// Размер кадров GIF
+const QSize kGifSize(640, 480);
+/// Число кадров GIF
+constexpr int kGifFrames = 50;
+/// Задержка между кадрами GIF в сотых долях секунды
+constexpr int kGifDelay = 10;
+
+}  // namespace
+
 s21::View::View(QWidget* parent) : QMainWindow(parent), ui(new Ui::View) {
   ui->setupUi(this);
   setWindowTitle("3DViewer v2.0");
@@ -30,21 +40,36 @@ s21::View::View(QWidget* parent) : QMainWindow(parent), ui(new Ui::View) {
   RenderControlPanels();
   LoadModel();
   syncInterfaceWithSettings();
+  gifTimer_ = new QTimer(this);
+  gifTimer_->setTimerType(Qt::PreciseTimer);
+  gifTimer_->setInterval(kGifDelay * 10);
+  connect(gifTimer_, &QTimer::timeout, this, &View::OnGifFrame);
+  connect(this, &View::gifSaved, this, &View::OnGifSaved);
 }
 
 s21::View::~View() {
+  // Рабочий поток дописывает файл до удаления виджетов.
+  gifTimer_->stop();
+  gifRecorder_.reset();
   delete modelViewWidget;
   delete ui;
 }
 
 void s21::View::LoadModel() {
   modelViewWidget = new s21::ModelRender(this);
+  connect(modelViewWidget, &ModelRender::shadersAvailabilityChanged, this,
+          &View::OnShadersAvailable);
   modelViewWidget->setMinimumSize(900, 680);
   modelViewWidget->setGeometry(5, 20, 900, 680);
   modelViewWidget->show();
   infoLabel_ = new QLabel(this);
   infoLabel_->setGeometry(5, 695, 900, 30);
   infoLabel_->show();
+  loadProgress_ = new QProgressBar(this);
+  loadProgress_->setGeometry(705, 701, 195, 18);
+  loadProgress_->setRange(0, 1000);
+  loadProgress_->setTextVisible(false);
+  loadProgress_->hide();
 }
 
 void s21::View::RenderControlPanels() {
@@ -69,16 +94,33 @@ void s21::View::SetupMenuBar() {
   connect(openAction, &QAction::triggered, this, &View::OnOpenFile);
   QAction* imageAction = new QAction("Save as Image", fileMenu);
   connect(imageAction, &QAction::triggered, this, &View::OnSaveImage);
-  QAction* gifAction = new QAction("Save as GIF", fileMenu);
-  connect(gifAction, &QAction::triggered, this, &View::OnSaveGIF);
+  gifAction_ = new QAction("Save as GIF", fileMenu);
+  connect(gifAction_, &QAction::triggered, this, &View::OnSaveGIF);
+  cancelLoadAction_ = new QAction("Cancel Loading", fileMenu);
+  cancelLoadAction_->setEnabled(false);
+  connect(cancelLoadAction_, &QAction::triggered, this,
+          &View::loadCancelRequested);
+  QAction* cacheAction = new QAction("Cache Parsed Models", fileMenu);
+  cacheAction->setCheckable(true);
+  connect(cacheAction, &QAction::toggled, this, &View::cacheToggled);
   QAction* exitAction = new QAction("Exit", fileMenu);
   connect(exitAction, &QAction::triggered, this, &QWidget::close);
 
   fileMenu->addAction(openAction);
+  fileMenu->addAction(cancelLoadAction_);
   fileMenu->addAction(imageAction);
-  fileMenu->addAction(gifAction);
+  fileMenu->addAction(gifAction_);
+  fileMenu->addAction(cacheAction);
   fileMenu->addAction(exitAction);
   menuBar->addMenu(fileMenu);
+
+  QMenu* viewMenu = new QMenu("View", menuBar);
+  QAction* shaderAction = new QAction("Shader Renderer", viewMenu);
+  shaderAction->setObjectName("ShaderRendererAction");
+  shaderAction->setCheckable(true);
+  connect(shaderAction, &QAction::toggled, this, &View::OnRendererChanged);
+  viewMenu->addAction(shaderAction);
+  menuBar->addMenu(viewMenu);
   setMenuBar(menuBar);
 }
 
@@ -452,6 +494,23 @@ void s21::View::OnProjectionTypeChanged() {
   }
 }
 
+void s21::View::OnRendererChanged(bool useShaders) {
+  if (modelViewWidget) {
+    modelViewWidget->setShaderRendering(useShaders);
+  }
+}
+
+void s21::View::OnShadersAvailable(bool available) {
+  QAction* shaderAction = findChild<QAction*>("ShaderRendererAction");
+  if (!shaderAction) return;
+  shaderAction->setEnabled(available);
+  shaderAction->setToolTip(
+      available ? QString() : "Shader renderer requires OpenGL 3.3");
+  QSignalBlocker blocker(shaderAction);
+  shaderAction->setChecked(
+      available && modelViewWidget->getSettings().use_shaders);
+}
+
 void s21::View::syncInterfaceWithSettings() {
   if (modelViewWidget) {
     const auto& settings = modelViewWidget->getSettings();
@@ -499,6 +558,10 @@ void s21::View::syncInterfaceWithSettings() {
       parallelRadioButton->setChecked(settings.is_parallel_projection);
       centralRadioButton->setChecked(!settings.is_parallel_projection);
     }
+    QAction* shaderAction = findChild<QAction*>("ShaderRendererAction");
+    if (shaderAction) {
+      shaderAction->setChecked(settings.use_shaders);
+    }
   }
 }
 
@@ -508,19 +571,6 @@ void s21::View::OnOpenFile() {
   if (!filePath.isEmpty()) {
     qDebug() << "File selected:" << filePath;
     emit filePathSelected(filePath);
-    previous_slider_state_.move_x = 0.0f;
-    previous_slider_state_.move_y = 0.0f;
-    previous_slider_state_.move_z = 0.0f;
-    previous_slider_state_.rotate_x = 180.0f;
-    previous_slider_state_.rotate_y = 180.0f;
-    previous_slider_state_.rotate_z = 180.0f;
-    previous_slider_state_.scale = 1.0f;
-    auto verticesCount = modelViewWidget->GetVertices().size() / 3;
-    auto facesCount = modelViewWidget->GetFaces().size() / 2;
-    infoLabel_->setText(QString("\tVertices: %1\t\t\tEdges: %2\t\t\tFile: %3")
-                            .arg(verticesCount)
-                            .arg(facesCount)
-                            .arg(filePath));
   } else {
     qDebug() << "No file selected.";
   }
@@ -541,30 +591,84 @@ void View::OnSaveImage() {
 }
 
 void View::OnSaveGIF() {
+  if (gifRecorder_) return;
   QString fileName = QFileDialog::getSaveFileName(
       this, "Save GIF", "", "GIF Files (*.gif);;All Files (*)");
   if (fileName.isEmpty()) return;
-  GifWriter gif;
-  if (!GifBegin(&gif, fileName.toLatin1().data(), 640, 480, 10)) {
-    QMessageBox::warning(this, "Error", "Failed to start GIF creation.");
+  try {
+    gifRecorder_ = std::make_unique<GifRecorder>(
+        fileName.toStdString(), kGifSize.width(), kGifSize.height(), kGifDelay,
+        [this, fileName](const std::string& error) {
+          QString message = QString::fromStdString(error);
+          QMetaObject::invokeMethod(
+              this,
+              [this, fileName, message] { emit gifSaved(fileName, message); },
+              Qt::QueuedConnection);
+        });
+  } catch (const std::exception& e) {
+    QMessageBox::warning(this, "Error",
+                         QString("Failed to start GIF creation: %1")
+                             .arg(e.what()));
     return;
   }
-  QSize gifSize(640, 480);
-  QTime timer;
-  for (int i = 0; i < 50; ++i) {
-    QImage frame = modelViewWidget->grabFramebuffer();
-    QImage scaledFrame =
-        frame.scaled(gifSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
-    QImage rgbaFrame = scaledFrame.convertToFormat(QImage::Format_RGBA8888);
-    GifWriteFrame(&gif, rgbaFrame.bits(), rgbaFrame.width(), rgbaFrame.height(),
-                  10);
-    timer = QTime::currentTime().addMSecs(100);
-    while (QTime::currentTime() < timer) {
-      QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
-    }
+  gifAction_->setEnabled(false);
+  gifInfoText_ = infoLabel_->text();
+  gifFramesLeft_ = kGifFrames;
+  gifFramesDropped_ = 0;
+  OnGifFrame();
+  gifTimer_->start();
+}
+
+void View::OnGifFrame() {
+  if (!gifRecorder_ || gifFramesLeft_ == 0) return;
+  QImage frame = modelViewWidget->grabFramebuffer()
+                     .scaled(kGifSize, Qt::IgnoreAspectRatio,
+                             Qt::SmoothTransformation)
+                     .convertToFormat(QImage::Format_RGBA8888);
+  // Захват не ждёт кодирования: если очередь заполнена, кадр отбрасывается,
+  // а запись продолжается, пока не наберётся kGifFrames кадров. После ошибки
+  // кодирования очередь закрыта: захват прекращается, а результат приходит
+  // сигналом gifSaved.
+  switch (gifRecorder_->TryPush(std::vector<std::uint8_t>(
+      frame.constBits(), frame.constBits() + frame.sizeInBytes()))) {
+    case GifRecorder::PushResult::kQueued:
+      --gifFramesLeft_;
+      break;
+    case GifRecorder::PushResult::kDropped:
+      ++gifFramesDropped_;
+      break;
+    case GifRecorder::PushResult::kClosed:
+      gifFramesLeft_ = 0;
+      break;
   }
-  GifEnd(&gif);
-  QMessageBox::information(this, "GIF Created", "GIF saved successfully.");
+  QString text = QString("\tRecording GIF: %1 / %2")
+                     .arg(kGifFrames - gifFramesLeft_)
+                     .arg(kGifFrames);
+  if (gifFramesDropped_) {
+    text += QString(", %1 frames dropped").arg(gifFramesDropped_);
+  }
+  infoLabel_->setText(text);
+  if (gifFramesLeft_ == 0) {
+    gifTimer_->stop();
+    gifRecorder_->Close();
+    infoLabel_->setText("\tEncoding GIF...");
+  }
+}
+
+void View::OnGifSaved(const QString& filePath, const QString& error) {
+  gifRecorder_.reset();
+  gifAction_->setEnabled(true);
+  if (!error.isEmpty()) {
+    infoLabel_->setText(gifInfoText_);
+    QMessageBox::warning(this, "Error",
+                         QString("Failed to create GIF: %1").arg(error));
+    return;
+  }
+  QString text = QString("%1\tGIF saved: %2").arg(gifInfoText_, filePath);
+  if (gifFramesDropped_) {
+    text += QString(" (%1 frames dropped)").arg(gifFramesDropped_);
+  }
+  infoLabel_->setText(text);
 }
 
 void s21::View::resetSliders() {
@@ -642,4 +746,47 @@ void s21::View::ShowError(const std::string& error_message) {
   QMessageBox::critical(this, "Error", QString::fromStdString(error_message));
 }
 
+void s21::View::ShowLoadStarted(const QString& filePath) {
+  loadingPath_ = filePath;
+  loadProgress_->setValue(0);
+  loadProgress_->show();
+  cancelLoadAction_->setEnabled(true);
+  infoLabel_->setText(QString("\tLoading: %1").arg(filePath));
+}
+
+void s21::View::ShowLoadProgress(const LoadProgress& progress) {
+  if (progress.bytes_total) {
+    loadProgress_->setValue(
+        static_cast<int>(progress.bytes_parsed * 1000 / progress.bytes_total));
+  }
+  infoLabel_->setText(
+      QString("\tLoading...\tVertices: %1\tFaces: %2\tRead: %3 / %4 MB")
+          .arg(progress.vertices)
+          .arg(progress.faces)
+          .arg(progress.bytes_parsed / (1024.0 * 1024.0), 0, 'f', 1)
+          .arg(progress.bytes_total / (1024.0 * 1024.0), 0, 'f', 1));
+}
+
+void s21::View::ShowLoadFinished() {
+  loadProgress_->hide();
+  cancelLoadAction_->setEnabled(false);
+  infoLabel_->clear();
+}
+
+void s21::View::ShowModelInfo(const MeshStats& stats,
+                              const QString& filePath) {
+  infoLabel_->setText(
+      QString("\tVertices: %1\tEdges: %2\tPolygons: %3\tMemory: %4 MB"
+              " (%5-bit indices, %6 KB saved)\tLoaded in %7 ms%8\tFile: %9")
+          .arg(stats.vertices)
+          .arg(stats.edges)
+          .arg(stats.polygons)
+          .arg(stats.memory_bytes / (1024.0 * 1024.0), 0, 'f', 1)
+          .arg(stats.index_size * 8)
+          .arg(stats.saved_bytes / 1024.0, 0, 'f', 0)
+          .arg(stats.load_seconds * 1000.0, 0, 'f', 0)
+          .arg(stats.from_cache ? " (cache)" : "")
+          .arg(filePath));
+}
+
 }  // namespace s21
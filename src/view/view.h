@@ -15,8 +15,16 @@
 #define VIEW_H
 
 // Standard Libraries
+#include <QMatrix4x4>
+#include <QOpenGLBuffer>
 #include <QOpenGLFunctions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLVertexArrayObject>
 #include <QOpenGLWidget>
+#include <QVector2D>
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 // Qt Widgets
@@ -34,15 +42,19 @@
 #include <QMenuBar>
 #include <QMessageBox>
 #include <QPainter>
+#include <QProgressBar>
 #include <QPushButton>
 #include <QRadioButton>
 #include <QSettings>
 #include <QSlider>
+#include <QTimer>
 #include <QVBoxLayout>
 
 // Internal Modules
 #include "../controller/axis.h"
 #include "../controller/controller.h"
+#include "../model/render/gif_recorder.h"
+#include "../model/render/software_renderer.h"
 #include "ui_view.h"
 
 QT_BEGIN_NAMESPACE
@@ -71,6 +83,8 @@ struct Settings {
   int vertex_shape;             ///< Форма вершин (круг, отсутствие или квадрат)
   bool is_parallel_projection;  ///< Тип проекции (параллельная или
                                 ///< перспективная)
+  bool use_shaders;             ///< Отрисовка шейдерами вместо
+                                ///< фиксированного конвейера
 };
 
 /**
@@ -103,12 +117,21 @@ class ModelRender : public QOpenGLWidget, protected QOpenGLFunctions {
   /**
    * @brief Устанавливает данные модели для отрисовки.
    *
-   * Принимает вершины и индексы рёбер для отображения 3D модели.
-   * @param vertices Список вершин модели.
-   * @param faces Список рёбер модели.
+   * Принимает разделяемые буферы вершин и индексов рёбер без копирования
+   * данных. Виджет держит буферы до следующего вызова, поэтому предыдущие
+   * буферы освобождаются и могут быть переиспользованы моделью. Если версии
+   * буферов не изменились, перерисовка не запрашивается.
+   * @param mesh Буферы вершин и рёбер модели.
    */
-  void setModelData(const std::vector<float>& vertices,
-                    const std::vector<unsigned int>& faces);
+  void setModelData(const MeshBuffer& mesh);
+
+  /**
+   * @brief Устанавливает матрицу модели.
+   *
+   * Матрица применяется к вершинам при отрисовке.
+   * @param matrix Матрица 4x4 в порядке по столбцам OpenGL.
+   */
+  void setModelMatrix(const std::array<float, 16>& matrix);
 
   /**
    * @brief Устанавливает цвет фона.
@@ -174,6 +197,27 @@ class ModelRender : public QOpenGLWidget, protected QOpenGLFunctions {
    */
   void setProjectionType(bool isParallel);
 
+  /**
+   * @brief Выбирает способ отрисовки.
+   *
+   * Шейдерная отрисовка использует VAO, вершинный и фрагментный шейдеры и
+   * матрицы модели, вида и проекции в uniform-переменных; пунктир и круглые
+   * точки строятся во фрагментном шейдере. Если шейдеры не удалось собрать,
+   * используется фиксированный конвейер.
+   * @param enabled true - шейдеры, false - фиксированный конвейер.
+   */
+  void setShaderRendering(bool enabled);
+
+  /**
+   * @brief Рисует текущий кадр без OpenGL.
+   *
+   * Кадр строится `SoftwareRenderer` по тем же вершинам, рёбрам, матрице и
+   * настройкам, что и `paintGL`, и не требует контекста OpenGL.
+   * @param size Размер изображения в пикселях.
+   * @return Изображение в формате RGBA8888.
+   */
+  QImage renderSoftware(const QSize& size) const;
+
   /**
    * @brief Устанавливает стандартные настройки для рёбер.
    *
@@ -197,19 +241,19 @@ class ModelRender : public QOpenGLWidget, protected QOpenGLFunctions {
    *
    * Метод возвращает вектор с координатами вершин модели.
    *
-   * @return std::vector<float> Вектор с координатами вершин.
+   * @return const std::vector<float>& Вектор с координатами вершин.
    */
-  std::vector<float> GetVertices();
+  const std::vector<float>& GetVertices() const;
 
   /**
    * @brief Получает список индексов граней модели.
    *
-   * Метод возвращает вектор с индексами граней (или треугольников), образующих
-   * модель.
+   * Метод возвращает пары индексов рёбер модели в 16- или 32-битном
+   * представлении, выбранном при загрузке.
    *
-   * @return std::vector<unsigned int> Вектор с индексами граней.
+   * @return const IndexBuffer& Буфер индексов рёбер.
    */
-  std::vector<unsigned int> GetFaces();
+  const IndexBuffer& GetFaces() const;
 
   /**
    * @brief Получает текущие настройки отображения.
@@ -221,12 +265,25 @@ class ModelRender : public QOpenGLWidget, protected QOpenGLFunctions {
    */
   const Settings& getSettings() const;
 
+ signals:
+  /**
+   * @brief Сигнал, испускаемый после инициализации контекста OpenGL.
+   *
+   * Шейдеры требуют GLSL 3.30, поэтому в контексте OpenGL 2.1, который,
+   * например, по умолчанию создаёт macOS, они недоступны и кадр рисуется
+   * фиксированным конвейером.
+   *
+   * @param available true, если шейдерная отрисовка доступна.
+   */
+  void shadersAvailabilityChanged(bool available);
+
  protected:
   /**
    * @brief Инициализация OpenGL.
    *
    * Метод вызывается при инициализации OpenGL. Устанавливает начальные
-   * параметры, такие как цвет фона и включение теста глубины.
+   * параметры, такие как цвет фона и включение теста глубины, и создаёт
+   * буферы вершин и индексов в памяти видеокарты.
    */
   void initializeGL() override;
 
@@ -246,11 +303,39 @@ class ModelRender : public QOpenGLWidget, protected QOpenGLFunctions {
    *
    * Метод вызывается для отрисовки содержимого окна. Он очищает буфер и
    * настраивает матрицу проекции, после чего вызывает методы для отрисовки
-   * рёбер и точек модели.
+   * рёбер и точек модели. Рёбра и точки читают вершины из одного буфера
+   * видеокарты, привязанного один раз за кадр.
    */
   void paintGL() override;
 
  private:
+  /**
+   * @brief Передаёт изменившиеся буферы модели в видеокарту.
+   *
+   * Буфер вершин обновляется, только если изменилась версия вершин: при
+   * прежнем размере - через `glBufferSubData`, иначе выделяется заново.
+   * Индексы рёбер передаются один раз после загрузки модели. Изменение
+   * размера окна, цветов или проекции не передаёт данные модели.
+   */
+  void UploadMesh();
+
+  /**
+   * @brief Собирает шейдерную программу и VAO.
+   *
+   * VAO запоминает буфер вершин как атрибут 0 и буфер индексов рёбер.
+   *
+   * @return true, если шейдерная отрисовка доступна в текущем контексте.
+   */
+  bool InitShaders();
+
+  /**
+   * @brief Отрисовывает рёбра и точки модели шейдерами.
+   *
+   * Матрицы передаются в uniform-переменные, поэтому преобразования модели
+   * не изменяют вершины в буфере.
+   */
+  void PaintWithShaders();
+
   /**
    * @brief Строит линии (рёбра) модели.
    *
@@ -283,8 +368,17 @@ class ModelRender : public QOpenGLWidget, protected QOpenGLFunctions {
    */
   void saveSettings() const;
 
-  std::vector<float> vertices_;      ///< Вершины модели
-  std::vector<unsigned int> faces_;  ///< Рёбра модели
+  MeshBuffer mesh_;  ///< Вершины и рёбра модели, разделяемые с моделью
+  QOpenGLBuffer vertex_buffer_{QOpenGLBuffer::VertexBuffer};  ///< VBO вершин
+  QOpenGLBuffer index_buffer_{QOpenGLBuffer::IndexBuffer};    ///< IBO рёбер
+  std::uint64_t uploaded_vertices_ = 0;  ///< Версия вершин в VBO
+  std::uint64_t uploaded_faces_ = 0;     ///< Версия индексов в IBO
+  QOpenGLShaderProgram program_;         ///< Шейдеры рёбер и точек
+  QOpenGLVertexArrayObject vao_;         ///< Привязка буферов для шейдеров
+  bool shaders_ready_ = false;           ///< Шейдеры собраны в контексте
+  std::array<float, 16> model_matrix_{1, 0, 0, 0, 0, 1, 0, 0,
+                                      0, 0, 1, 0, 0, 0, 0, 1};  ///< Матрица
+                                                                ///< модели
   Settings settings_;  ///< Структура для хранения настроек отображения
   bool initialSettings = false;  ///< Проверка первого запуска программы для
                                  ///< создания файла настроек
@@ -377,6 +471,38 @@ class View : public QMainWindow {
    */
   void ShowError(const std::string& error_message);
 
+  /**
+   * @brief Отображает начало загрузки модели.
+   *
+   * Показывает индикатор хода загрузки и делает доступным действие отмены.
+   *
+   * @param filePath Путь к загружаемому файлу.
+   */
+  void ShowLoadStarted(const QString& filePath);
+
+  /**
+   * @brief Отображает ход загрузки модели.
+   *
+   * @param progress Число разобранных байтов, прочитанных вершин и граней.
+   */
+  void ShowLoadProgress(const LoadProgress& progress);
+
+  /**
+   * @brief Скрывает индикатор загрузки после её завершения или отмены.
+   */
+  void ShowLoadFinished();
+
+  /**
+   * @brief Отображает сведения о загруженной модели.
+   *
+   * Подключается к сигналу `Controller::modelLoaded`.
+   *
+   * @param stats Число вершин, рёбер и граней, занимаемая память и время
+   * загрузки.
+   * @param filePath Путь к файлу модели.
+   */
+  void ShowModelInfo(const MeshStats& stats, const QString& filePath);
+
  signals:
 
   /**
@@ -389,6 +515,21 @@ class View : public QMainWindow {
    */
   void filePathSelected(const QString& filePath);
 
+  /**
+   * @brief Сигнал, испускаемый при запросе отмены загрузки модели.
+   */
+  void loadCancelRequested();
+
+  /**
+   * @brief Сигнал, испускаемый при включении или выключении кэша моделей.
+   *
+   * Кэш выключен по умолчанию, поскольку записывает файл `.s21cache` рядом с
+   * каждой открытой моделью.
+   *
+   * @param enabled Кэш включён.
+   */
+  void cacheToggled(bool enabled);
+
   /**
    * @brief Сигнал, испускаемый при изменении значения слайдера для движения.
    *
@@ -423,6 +564,17 @@ class View : public QMainWindow {
    */
   void scaleChanged(float value);
 
+  /**
+   * @brief Сигнал, испускаемый после записи GIF.
+   *
+   * Испускается в потоке интерфейса, когда рабочий поток `GifRecorder`
+   * закодировал все кадры и закрыл файл.
+   *
+   * @param filePath Путь к файлу GIF.
+   * @param error Описание ошибки или пустая строка.
+   */
+  void gifSaved(const QString& filePath, const QString& error);
+
  private slots:
 
   /**
@@ -447,15 +599,37 @@ class View : public QMainWindow {
   void OnSaveImage();
 
   /**
-   * @brief Сохраняет текущий вид как GIF в указанное место.
+   * @brief Начинает запись текущего вида в GIF.
    *
    * Эта функция открывает диалог QFileDialog для выбора местоположения и имени
-   * файла для сохранения GIF. Она захватывает 50 кадров с виджета модели,
-   * масштабирует их и сохраняет как GIF файл. Если создание GIF не удалось,
-   * отображается сообщение об ошибке.
+   * файла для сохранения GIF, создаёт `GifRecorder` и запускает таймер
+   * захвата. Кадры кодируются в рабочем потоке, поэтому интерфейс не
+   * блокируется; о завершении сообщает сигнал `gifSaved`.
    */
   void OnSaveGIF();
 
+  /**
+   * @brief Захватывает очередной кадр GIF.
+   *
+   * Вызывается таймером с интервалом задержки кадра. Кадр масштабируется до
+   * размера GIF и передаётся в очередь `GifRecorder` без ожидания: если
+   * кодирование отстало и очередь заполнена, кадр отбрасывается, а число
+   * отброшенных кадров показывается в строке состояния. После последнего
+   * кадра очередь закрывается.
+   */
+  void OnGifFrame();
+
+  /**
+   * @brief Завершает запись GIF.
+   *
+   * Подключается к сигналу `gifSaved`: освобождает `GifRecorder`, снова
+   * разрешает запись и показывает результат.
+   *
+   * @param filePath Путь к файлу GIF.
+   * @param error Описание ошибки или пустая строка.
+   */
+  void OnGifSaved(const QString& filePath, const QString& error);
+
  private:
   /**
    * @brief Загружает и отображает окно отрисовки в виджете ModelRender.
@@ -480,7 +654,7 @@ class View : public QMainWindow {
    *
    * Создаёт строку меню с пунктами для работы с файлами: открыть файл,
    * сохранить изображение, сохранить в формате GIF, а также выход из
-   * приложения.
+   * приложения. Меню "View" переключает шейдерную отрисовку.
    */
   void SetupMenuBar();
 
@@ -697,6 +871,26 @@ class View : public QMainWindow {
    */
   void OnProjectionTypeChanged();
 
+  /**
+   * @brief Обрабатывает переключение способа отрисовки.
+   *
+   * Вызывается пунктом меню "View > Shader Renderer" и передаёт выбор
+   * виджету отрисовки.
+   *
+   * @param useShaders true - шейдерная отрисовка.
+   */
+  void OnRendererChanged(bool useShaders);
+
+  /**
+   * @brief Обновляет пункт меню шейдерной отрисовки.
+   *
+   * Если шейдеры недоступны в контексте OpenGL, пункт снимается и
+   * отключается, а сохранённый выбор пользователя не изменяется.
+   *
+   * @param available true, если шейдерная отрисовка доступна.
+   */
+  void OnShadersAvailable(bool available);
+
   /**
    * @brief Соединяет слайдер с сигналом изменения, передавая изменения значения
    * в соответствующий метод.
@@ -758,6 +952,16 @@ class View : public QMainWindow {
       nullptr;  ///< Указатель на виджет для рендеринга модели
   QLabel* infoLabel_ =
       nullptr;  ///< Указатель на метку для отображения информации о модели
+  QProgressBar* loadProgress_ =
+      nullptr;  ///< Индикатор хода загрузки модели
+  QAction* cancelLoadAction_ = nullptr;  ///< Действие отмены загрузки модели
+  QAction* gifAction_ = nullptr;         ///< Действие записи GIF
+  QTimer* gifTimer_ = nullptr;           ///< Таймер захвата кадров GIF
+  std::unique_ptr<GifRecorder> gifRecorder_;  ///< Кодирование текущего GIF
+  int gifFramesLeft_ = 0;     ///< Число кадров GIF, которые осталось захватить
+  int gifFramesDropped_ = 0;  ///< Число кадров, отброшенных при захвате
+  QString gifInfoText_;       ///< Текст метки до начала записи GIF
+  QString loadingPath_;  ///< Путь к загружаемому файлу
   SliderState previous_slider_state_;  ///< Структура для хранения предыдущего
                                        ///< состояния слайдеров
   static const QMap<QString, QColor>
@@ -15,20 +15,44 @@ SOURCES += \
     openGLfuncs.cc \
     view.cc \
     ../model/model.cc \
+    ../model/model_loader.cc \
     ../model/parser/parser.cc \
+    ../model/parser/mapped_file.cc \
+    ../model/parser/mesh_cache.cc \
+    ../model/parser/index_buffer.cc \
+    ../model/parser/mesh_buffer.cc \
+    ../model/parser/edge_builder.cc \
     ../model/affine_transform/affinetransform.cc \
     ../libs/s21_matrix_oop.cc \
     ../model/affine_transform/factory.cc \
+    ../model/affine_transform/transform_kernel.cc \
+    ../model/concurrency/thread_pool.cc \
+    ../model/render/software_renderer.cc \
+    ../model/render/image_writer.cc \
+    ../model/render/gif_recorder.cc \
     ../controller/controller.cc
 
 HEADERS += \
     ../controller/axis.h\
     view.h \
     ../model/model.h \
+    ../model/model_loader.h \
     ../model/parser/parser.h \
+    ../model/parser/mapped_file.h \
+    ../model/parser/mesh_cache.h \
+    ../model/parser/index_buffer.h \
+    ../model/parser/mesh_buffer.h \
+    ../model/parser/edge_builder.h \
     ../model/affine_transform/affinetransform.h \
     ../libs/s21_matrix_oop.h \
     ../model/affine_transform/factory.h \
+    ../model/affine_transform/mat4.h \
+    ../model/affine_transform/transform_kernel.h \
+    ../model/concurrency/thread_pool.h \
+    ../model/concurrency/bounded_queue.h \
+    ../model/render/software_renderer.h \
+    ../model/render/image_writer.h \
+    ../model/render/gif_recorder.h \
     ../controller/controller.h
 
 FORMS += \